@@ -2,11 +2,61 @@
 #include <vector>
 #include <string>
 #include <algorithm> // For std::sort, std::lower_bound, std::upper_bound
-#include <iomanip>   // For std::setw, std::left, std::right
-#include <limits>    // For numeric_limits
-#include <map>       // For std::map
-#include <set>       // To help with unique department listing and date mapping
-#include <cstdlib>   // Required for system("cls") or system("clear")
+#include <iomanip>   // For std::setw, std::left, std::right
+#include <limits>    // For numeric_limits
+#include <map>       // For std::map
+#include <memory>    // For std::unique_ptr (event store chunks)
+#include <cstdint>   // For fixed-width integer types (event handles)
+#include <cstdlib>   // Required for system("cls") or system("clear")
+#include <cstdio>    // For snprintf (date/time formatting) and FILE-based log writing
+#include <cstring>   // For memcpy, memcmp (binary encoding)
+#include <fstream>   // For std::ifstream
+#include <filesystem> // For std::filesystem::resize_file (log repair)
+#include <thread>    // For std::thread (parallel import parsing, worker pool)
+#include <mutex>     // For std::mutex (worker pool)
+#include <condition_variable> // For std::condition_variable (worker pool)
+#include <atomic>    // For std::atomic (worker pool)
+#include <unordered_map> // For std::unordered_map (department n-grams)
+#include <string_view> // For std::string_view (name index lookups)
+#include <functional> // For std::hash
+#include <deque>     // For std::deque (stable storage of interned strings)
+#include <queue>     // For std::priority_queue (merging department lists)
+#include <cctype>    // For isspace, tolower
+#include <chrono>    // For timing bulk imports, batch runs and benchmarks
+#include <random>    // For std::mt19937_64 (synthetic benchmark data)
+#include <sstream>   // For std::stringstream (option parsing)
+#include <charconv>  // For std::to_chars, std::from_chars (table rendering, escapes)
+#include <cerrno>    // For errno (log write errors, non-blocking socket I/O)
+
+#ifndef _WIN32
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap (snapshot loading)
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close, fsync, ftruncate
+#else
+#include <io.h>       // For _commit, _chsize_s, _fileno
+#endif
+
+#ifdef __linux__
+#include <csignal>       // For sigaction (stopping the server)
+#include <sys/epoll.h>   // For epoll (network server)
+#include <sys/socket.h>  // For socket, accept4, send, recv
+#include <netinet/in.h>  // For sockaddr_in
+#include <netinet/tcp.h> // For TCP_NODELAY
+#include <arpa/inet.h>   // For htons, htonl
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h> // For the AVX2 column scan kernels
+#endif
+
+#if __has_include(<bit>)
+#include <bit> // For std::popcount, std::countr_zero where available (portable helpers)
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h> // For _InterlockedExchangeAdd, _BitScanForward64 (portable helpers)
+#endif
 
 using namespace std;
 
@@ -14,630 +64,5656 @@ using namespace std;
 // --- CLEAR SCREEN FUNCTION ---
 void clearScreen() {
 #ifdef _WIN32
-    system("cls"); // For Windows
+    system("cls"); // For Windows
 #else
-    system("clear"); // For Linux and macOS
+    system("clear"); // For Linux and macOS
 #endif
 }
 
+// --- Date and Time Representation ---
+// Dates and times are parsed once on input and stored as integers, so every comparison
+// on the sort and search paths is a single integer compare. They are only turned back
+// into text when displayed.
+// A date is a day number: the number of days since 1970-01-01.
+typedef int32_t DayNumber;
+// A time of day is the number of minutes since midnight, in [0, 1440).
+typedef uint16_t MinuteOfDay;
+
+// Calendar window supported by the date index.
+const int MIN_EVENT_YEAR = 1970;
+const int MAX_EVENT_YEAR = 2199;
+
+// Converts a civil date (year, month, day) to its day number.
+// Uses the standard era-based algorithm, valid for the full proleptic Gregorian calendar.
+constexpr DayNumber daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const int yoe = y - era * 400;                                 // [0, 399]
+    const int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1; // [0, 365]
+    const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;          // [0, 146096]
+    return era * 146097 + doe - 719468;
+}
+
+// Converts a day number back to its civil date (inverse of daysFromCivil).
+void civilFromDays(DayNumber z, int& y, int& m, int& d) {
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const int doe = z - era * 146097;                                     // [0, 146096]
+    const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365; // [0, 399]
+    const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);              // [0, 365]
+    const int mp = (5 * doy + 2) / 153;                                   // [0, 11]
+    d = doy - (153 * mp + 2) / 5 + 1;
+    m = mp < 10 ? mp + 3 : mp - 9;
+    y = yoe + era * 400 + (m <= 2);
+}
+
+// Number of day numbers covered by the date index: [0, DAY_RANGE).
+const DayNumber DAY_RANGE = daysFromCivil(MAX_EVENT_YEAR + 1, 1, 1);
+
+// Parses a strict "YYYY-MM-DD" date inside the supported window into a day number.
+// Returns false if the text is malformed or names a day that does not exist.
+bool parseDate(const string& text, DayNumber& day) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') {
+        return false;
+    }
+    for (int i : {0, 1, 2, 3, 5, 6, 8, 9}) {
+        if (text[i] < '0' || text[i] > '9') return false;
+    }
+    int y = stoi(text.substr(0, 4));
+    int m = stoi(text.substr(5, 2));
+    int d = stoi(text.substr(8, 2));
+    if (y < MIN_EVENT_YEAR || y > MAX_EVENT_YEAR || m < 1 || m > 12 || d < 1) {
+        return false;
+    }
+    static const int daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    int monthLength = daysInMonth[m - 1] + (m == 2 && leap ? 1 : 0);
+    if (d > monthLength) {
+        return false;
+    }
+    day = daysFromCivil(y, m, d);
+    return true;
+}
+
+// Parses a strict 24-hour "HH:MM" time into minutes since midnight.
+bool parseTime(const string& text, MinuteOfDay& minutes) {
+    if (text.size() != 5 || text[2] != ':') {
+        return false;
+    }
+    for (int i : {0, 1, 3, 4}) {
+        if (text[i] < '0' || text[i] > '9') return false;
+    }
+    int h = (text[0] - '0') * 10 + (text[1] - '0');
+    int m = (text[3] - '0') * 10 + (text[4] - '0');
+    if (h > 23 || m > 59) {
+        return false;
+    }
+    minutes = h * 60 + m;
+    return true;
+}
+
+// Formats a day number as "YYYY-MM-DD".
+string formatDate(DayNumber day) {
+    int y, m, d;
+    civilFromDays(day, y, m, d);
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", y, m, d);
+    return buffer;
+}
+
+// Formats minutes since midnight as "HH:MM".
+string formatTime(MinuteOfDay minutes) {
+    char buffer[8];
+    snprintf(buffer, sizeof(buffer), "%02d:%02d", minutes / 60, minutes % 60);
+    return buffer;
+}
+
+// Writes 'value' as exactly 'count' zero-padded digits.
+void writeDigits(char* out, int value, int count) {
+    for (int i = count - 1; i >= 0; i--) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+// Writes a day number as the 10 characters "YYYY-MM-DD", without a temporary string,
+// and returns the end. Years in the supported window always have four digits.
+char* writeDate(char* out, DayNumber day) {
+    int y, m, d;
+    civilFromDays(day, y, m, d);
+    writeDigits(out, y, 4);
+    out[4] = '-';
+    writeDigits(out + 5, m, 2);
+    out[7] = '-';
+    writeDigits(out + 8, d, 2);
+    return out + 10;
+}
+
+// Writes minutes since midnight as the 5 characters "HH:MM" and returns the end.
+char* writeTime(char* out, MinuteOfDay minutes) {
+    writeDigits(out, minutes / 60, 2);
+    out[2] = ':';
+    writeDigits(out + 3, minutes % 60, 2);
+    return out + 5;
+}
+
+// --- String Interning ---
+// Departments, locations and courses come from small vocabularies repeated across many
+// records. Each distinct value is stored once in a pool and records hold its dense 32-bit
+// SymbolId instead of a string copy, so grouping by the value is an array lookup and
+// comparing two values is an integer compare. Pools only grow; ids are never reused.
+// On disk the text is written, so ids never need to be stable across runs.
+typedef uint32_t SymbolId;
+const SymbolId NO_SYMBOL = UINT32_MAX;
+
+struct SymbolPool {
+    deque<string> texts;                      // Indexed by id; deque keeps elements in place
+    unordered_map<string_view, SymbolId> ids; // Views into 'texts'
+
+    size_t size() const { return texts.size(); }
+
+    const string& text(SymbolId id) const { return texts[id]; }
+
+    // Returns the id of 'value', or NO_SYMBOL if it has never been interned.
+    SymbolId find(string_view value) const {
+        auto it = ids.find(value);
+        return it == ids.end() ? NO_SYMBOL : it->second;
+    }
+
+    // Returns the id of 'value', adding it to the pool if it is new.
+    SymbolId intern(string_view value) {
+        auto it = ids.find(value);
+        if (it != ids.end()) return it->second;
+        SymbolId id = static_cast<SymbolId>(texts.size());
+        texts.emplace_back(value);
+        ids.emplace(texts.back(), id);
+        return id;
+    }
+};
+
+SymbolPool departmentPool;
+SymbolPool locationPool;
+SymbolPool coursePool;
+
 // --- NEW Participant Structure ---
+// A registration as entered or read from a file; stored rosters use RosterEntry.
 struct Participant {
-    string name;
-    string course;
+    string name;
+    SymbolId course; // In coursePool
+};
+
+// --- Roster Arena ---
+// Every event's roster is a block of 'capacity' RosterEntry slots reserved in a shared
+// arena when the event is stored, and participant names are copied into a shared byte
+// arena. Registering a participant therefore fills the next reserved slot and bumps the
+// name arena: no per-registration heap allocation, no vector regrowth, and each roster
+// sits contiguously in memory. Arena chunks are never moved or freed while the store
+// lives, so entries and names stay put. Slots are not initialised on reservation, so
+// pages of a large reserved block cost no memory until registrations are written there.
+//
+// Registrations may run on several threads at once (see addParticipant). A registration
+// claims its slot number with an atomic compare-and-increment of the event's counter,
+// so the slot is its own to fill and no roster needs a lock; names go to one of several
+// name arenas, each with its own lock, picked per thread.
+const int MAX_EVENT_CAPACITY = 100000;
+const size_t ROSTER_CHUNK_ENTRIES = 1 << 16;
+const size_t NAME_CHUNK_BYTES = 1 << 20;
+
+struct RosterEntry {
+    const char* name;    // In a participant name arena, not NUL-terminated
+    uint32_t nameLength;
+    SymbolId course;     // In coursePool
+};
+
+// Bump allocator over fixed-size chunks. A request larger than a chunk gets a block
+// of its own.
+template <typename T>
+struct ChunkedArena {
+    vector<unique_ptr<T[]>> chunks;
+    size_t chunkSize;
+    size_t used = 0;      // Elements handed out from the newest chunk
+    size_t available = 0; // Elements left in the newest chunk
+
+    explicit ChunkedArena(size_t size) : chunkSize(size) {}
+
+    T* allocate(size_t count) {
+        if (count > available) {
+            size_t size = max(count, chunkSize);
+            chunks.emplace_back(new T[size]); // Trivial T: left uninitialised
+            used = 0;
+            available = size;
+        }
+        T* block = chunks.back().get() + used;
+        used += count;
+        available -= count;
+        return block;
+    }
+
+    void clear() {
+        chunks.clear();
+        used = 0;
+        available = 0;
+    }
+};
+
+ChunkedArena<RosterEntry> rosterArena(ROSTER_CHUNK_ENTRIES);
+
+// Participant names, sharded so that registering threads rarely share a lock.
+const size_t NAME_ARENA_SHARDS = 16;
+
+struct NameArenaShard {
+    mutex lock;
+    ChunkedArena<char> arena{NAME_CHUNK_BYTES};
+};
+
+NameArenaShard participantNameArenas[NAME_ARENA_SHARDS];
+
+// Copies a participant name into the calling thread's name arena and returns the copy.
+const char* storeParticipantName(string_view name) {
+    static atomic<size_t> nextShard{0};
+    thread_local size_t shard = nextShard++ % NAME_ARENA_SHARDS;
+    NameArenaShard& names = participantNameArenas[shard];
+    lock_guard<mutex> guard(names.lock);
+    char* stored = names.arena.allocate(name.size());
+    memcpy(stored, name.data(), name.size());
+    return stored;
+}
+
+// Frees every stored participant name.
+void clearParticipantNames() {
+    for (NameArenaShard& names : participantNameArenas) {
+        lock_guard<mutex> guard(names.lock);
+        names.arena.clear();
+    }
+}
+
+// Registrations waiting for an earlier roster slot to be committed sleep on one of
+// these, picked by the address of the event's seat counter.
+const size_t SEAT_WAIT_SHARDS = 16;
+
+struct SeatWaitShard {
+    mutex lock;
+    condition_variable committed;
+};
+
+SeatWaitShard seatWaitShards[SEAT_WAIT_SHARDS];
+
+// Returns the wait shard of the seat counter at 'counter'. Counters sit one event
+// apart, so the address is mixed before it is reduced to a shard.
+SeatWaitShard& seatWaitShard(const void* counter) {
+    uint64_t mixed = uint64_t(reinterpret_cast<uintptr_t>(counter)) * 0x9E3779B97F4A7C15ull;
+    return seatWaitShards[(mixed >> 32) % SEAT_WAIT_SHARDS];
+}
+
+// Spins a commit makes on an earlier slot before it sleeps.
+const int SEAT_COMMIT_SPINS = 64;
+
+// Roster slots of an event. 'reserved' counts slots claimed by registrations and
+// 'committed' the leading slots whose entries are written; the count an event reports
+// is the committed one, so a reader never sees a claimed slot before its entry.
+// Copying an event copies the committed count.
+struct SeatCounter {
+    atomic<int> reserved{0};
+    atomic<int> committed{0};
+    atomic<int> sleepers{0}; // Commits asleep in seatWaitShards for an earlier slot
+
+    SeatCounter() = default;
+    SeatCounter(int count) : reserved(count), committed(count) {}
+    SeatCounter(const SeatCounter& other) : SeatCounter(int(other)) {}
+    SeatCounter& operator=(const SeatCounter& other) {
+        int count = other;
+        reserved.store(count, memory_order_relaxed);
+        committed.store(count, memory_order_relaxed);
+        return *this;
+    }
+
+    operator int() const { return committed.load(memory_order_acquire); }
+
+    // Claims the next slot if fewer than 'limit' are reserved. Returns the slot number,
+    // or -1 if the event is full. Lock-free: a failed exchange means another thread
+    // claimed a slot in between, so the count is re-checked against the limit and retried.
+    int claim(int limit) {
+        int taken = reserved.load(memory_order_relaxed);
+        while (taken < limit) {
+            if (reserved.compare_exchange_weak(taken, taken + 1, memory_order_acq_rel, memory_order_relaxed)) {
+                return taken;
+            }
+        }
+        return -1;
+    }
+
+    // Publishes 'slot' once its entry is written. Slots are committed in order, so this
+    // waits for registrations that claimed an earlier slot to write theirs. That is
+    // usually only the few stores between their claim and their commit, so it spins
+    // briefly first; if the earlier registration has been descheduled it sleeps instead.
+    // 'sleepers' and 'committed' are sequentially consistent so that a commit either
+    // sees a sleeper and wakes it or the sleeper sees the commit before waiting.
+    void commit(int slot) {
+        for (int spin = 0; committed.load(memory_order_acquire) != slot; spin++) {
+            if (spin < SEAT_COMMIT_SPINS) {
+                this_thread::yield();
+                continue;
+            }
+            SeatWaitShard& shard = seatWaitShard(this);
+            unique_lock<mutex> guard(shard.lock);
+            sleepers.fetch_add(1);
+            shard.committed.wait(guard, [&] { return committed.load() == slot; });
+            sleepers.fetch_sub(1);
+            break;
+        }
+        committed.store(slot + 1);
+        if (sleepers.load() > 0) {
+            SeatWaitShard& shard = seatWaitShard(this);
+            lock_guard<mutex> guard(shard.lock);
+            shard.committed.notify_all();
+        }
+    }
 };
 
+// Returns a roster entry's participant name.
+string_view rosterName(const RosterEntry& entry) {
+    return string_view(entry.name, entry.nameLength);
+}
+
 // --- Existing Event Structure ---
 struct Event {
-    int id;
-    string name;
-    string date;
-    string startTime; // NEW: Start time of the event
-    string endTime;   // NEW: End time of the event
-    string location;
-    string department;
-    int capacity;
-    int participants; // This still tracks the count
-    vector<Participant> registeredParticipants; // NEW: Stores actual participant details
-
-    // Overload the less than operator for sorting by name (for main events vector)
-    // This allows std::sort to work directly on the events vector by name.
-    bool operator<(const Event& other) const {
-        return name < other.name; // Sort by event name
-    }
-};
-
-// Global vector to store all events (primary storage, sorted by name)
-vector<Event> events;
+    int id;
+    string name;
+    DayNumber date;        // Parsed from YYYY-MM-DD on input
+    MinuteOfDay startTime; // Start time of the event (minutes since midnight)
+    MinuteOfDay endTime;   // End time of the event (minutes since midnight)
+    SymbolId location;   // In locationPool
+    SymbolId department; // In departmentPool
+    int capacity;
+    SeatCounter participants; // Number of committed roster slots
+    RosterEntry* roster; // 'capacity' slots reserved when the event is stored
+
+    // Overload the less than operator for sorting by name.
+    // This allows std::sort to order Event values by name.
+    bool operator<(const Event& other) const {
+        return name < other.name; // Sort by event name
+    }
+};
+
+// --- Event Store ---
+// Events are identified by a stable handle: the slot number of the event in the store.
+// Handles are dense and derived from the ID (handle = id - 1), so they survive inserts,
+// never need fixing up, and are half the size of a pointer in every index entry.
+typedef uint32_t EventHandle;
+
+// Number of events per storage chunk.
+const size_t EVENT_CHUNK_SIZE = 4096;
+// Size of the chunk directory, which bounds the store at 65536 chunks (268M events).
+const size_t MAX_EVENT_CHUNKS = 1 << 16;
+
+// Chunked arena holding all events (primary storage, in insertion/ID order).
+// Events live in fixed-size chunks that are never reallocated, so an event never moves
+// once stored. Name order is provided by the name trie rather than by sorting this store.
+// The chunk directory is allocated once and never grows, so reader threads can look up
+// stored events while the writer adds chunks.
+struct EventStore {
+    unique_ptr<unique_ptr<Event[]>[]> chunks{new unique_ptr<Event[]>[MAX_EVENT_CHUNKS]};
+    size_t count = 0;
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Event& operator[](EventHandle handle) {
+        return chunks[handle / EVENT_CHUNK_SIZE][handle % EVENT_CHUNK_SIZE];
+    }
+    const Event& operator[](EventHandle handle) const {
+        return chunks[handle / EVENT_CHUNK_SIZE][handle % EVENT_CHUNK_SIZE];
+    }
+
+    // Stores a copy of the event in the next free slot, assigns its ID, reserves its
+    // (empty) roster and returns its handle.
+    EventHandle add(const Event& event) {
+        if (count % EVENT_CHUNK_SIZE == 0) {
+            chunks[count / EVENT_CHUNK_SIZE].reset(new Event[EVENT_CHUNK_SIZE]);
+        }
+        EventHandle handle = count++;
+        Event& slot = (*this)[handle];
+        slot = event;
+        slot.id = handle + 1;
+        slot.roster = rosterArena.allocate(slot.capacity);
+        slot.participants = 0;
+        return handle;
+    }
+
+    // Frees every event.
+    void clear() {
+        for (size_t chunk = 0; chunk * EVENT_CHUNK_SIZE < count; chunk++) {
+            chunks[chunk].reset();
+        }
+        count = 0;
+    }
+};
+
+// Marks "no event" wherever an index slot or trie node may be empty.
+const EventHandle NO_EVENT = UINT32_MAX;
+
+// Appends a participant to the event's reserved roster slots. Returns false if the event
+// is full. Safe to call from several threads at once.
+bool appendRosterEntry(Event& event, string_view name, SymbolId course) {
+    int slot = event.participants.claim(event.capacity);
+    if (slot < 0) {
+        return false;
+    }
+    event.roster[slot] = {storeParticipantName(name), static_cast<uint32_t>(name.size()), course};
+    event.participants.commit(slot);
+    return true;
+}
+
+// Converts an event ID to its handle in the store.
+EventHandle handleForId(int id) {
+    return id - 1;
+}
+
+// Global event store (primary storage).
+EventStore events;
+
+// --- Portable Helpers ---
+// Operations that C++17 has no standard spelling for. Each uses the standard library
+// where the compiler provides it and a compiler intrinsic otherwise.
+
+// Atomically adds 'delta' to a plain int32_t that other threads may update concurrently,
+// with no ordering guarantees beyond the update itself.
+inline void atomicAddRelaxed(int32_t& value, int32_t delta) {
+#if defined(__cpp_lib_atomic_ref)
+    atomic_ref<int32_t>(value).fetch_add(delta, memory_order_relaxed);
+#elif defined(_MSC_VER)
+    static_assert(sizeof(long) == sizeof(int32_t), "interlocked add works on long");
+    _InterlockedExchangeAdd(reinterpret_cast<volatile long*>(&value), delta);
+#else
+    __atomic_fetch_add(&value, delta, __ATOMIC_RELAXED);
+#endif
+}
+
+// Returns the number of set bits in 'word'.
+inline int popcount64(uint64_t word) {
+#if defined(__cpp_lib_bitops)
+    return popcount(word);
+#elif defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ull);
+    word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return static_cast<int>((word * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// Returns the index of the lowest set bit in 'word', which must not be zero.
+inline int countTrailingZeros64(uint64_t word) {
+#if defined(__cpp_lib_bitops)
+    return countr_zero(word);
+#elif defined(__GNUC__)
+    return __builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<int>(index);
+#else
+    return popcount64((word & (0 - word)) - 1); // Ones below the lowest set bit
+#endif
+}
+
+// --- Event Columns ---
+// A struct-of-arrays copy of the integer fields that filter and aggregate queries scan,
+// one contiguous array per field, indexed by handle (the event ID is handle + 1, so it
+// needs no column). A scan over dates or seat counts then reads only those arrays,
+// a few bytes per event, instead of pulling whole Event records (names, rosters and
+// all) through the cache. The store stays the source of truth: insertEvent() and
+// addParticipant() keep the columns current, and full rebuilds regenerate them.
+struct EventColumns {
+    vector<DayNumber> date;
+    vector<int32_t> capacity;
+    vector<int32_t> participants;
+    vector<SymbolId> department;
+
+    size_t size() const { return date.size(); }
+
+    void clear() {
+        date.clear();
+        capacity.clear();
+        participants.clear();
+        department.clear();
+    }
+
+    void append(const Event& event) {
+        date.push_back(event.date);
+        capacity.push_back(event.capacity);
+        participants.push_back(event.participants);
+        department.push_back(event.department);
+    }
+};
+
+EventColumns eventColumns;
+
+// Regenerates every column from the event store.
+void rebuildEventColumns() {
+    eventColumns.clear();
+    for (EventHandle h = 0; h < events.size(); h++) {
+        eventColumns.append(events[h]);
+    }
+}
+
+// --- Column Scan Kernels ---
+// Predicate scans over the event columns that produce a selection bitmap (bit i set when
+// the event with handle i matches). Each filter supplies a scalar test, used as the
+// fallback and for the last few events, and on x86 an AVX2 test of eight consecutive
+// events at once. The AVX2 versions are compiled for that instruction set alone and are
+// only called after checking the CPU at run time, so the program still runs on any
+// x86-64 (or other) processor.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UEVENTS_AVX2_KERNELS 1
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+
+// Returns true if the running CPU supports the AVX2 kernels.
+bool cpuSupportsAvx2() {
+#ifdef UEVENTS_AVX2_KERNELS
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+// Whether scans use the AVX2 kernels. Cleared by the benchmark to time the scalar path.
+bool simdKernelsEnabled = cpuSupportsAvx2();
+
+// Events on one day.
+struct DateEqualsFilter {
+    const DayNumber* date;
+    DayNumber day;
+
+    bool operator()(size_t i) const { return date[i] == day; }
+#ifdef UEVENTS_AVX2_KERNELS
+    AVX2_TARGET uint32_t laneMask(size_t i) const {
+        __m256i dates = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(date + i));
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(dates, _mm256_set1_epi32(day))));
+    }
+#endif
+};
+
+// Events of one department that still have free seats.
+struct FreeSeatsFilter {
+    const SymbolId* department;
+    const int32_t* capacity;
+    const int32_t* participants;
+    SymbolId wanted;
+
+    bool operator()(size_t i) const { return department[i] == wanted && participants[i] < capacity[i]; }
+#ifdef UEVENTS_AVX2_KERNELS
+    AVX2_TARGET uint32_t laneMask(size_t i) const {
+        __m256i departments = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(department + i));
+        __m256i seats = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(capacity + i));
+        __m256i taken = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(participants + i));
+        __m256i inDepartment = _mm256_cmpeq_epi32(departments, _mm256_set1_epi32(static_cast<int>(wanted)));
+        __m256i hasRoom = _mm256_cmpgt_epi32(seats, taken);
+        return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_and_si256(inDepartment, hasRoom)));
+    }
+#endif
+};
+
+// Events whose registrations reach 'percent' of capacity. Compared in double precision,
+// which is exact for every int32 value, so large capacities cannot overflow.
+struct OccupancyFilter {
+    const int32_t* capacity;
+    const int32_t* participants;
+    int percent;
+
+    bool operator()(size_t i) const {
+        return static_cast<double>(participants[i]) * 100 >= static_cast<double>(capacity[i]) * percent;
+    }
+#ifdef UEVENTS_AVX2_KERNELS
+    AVX2_TARGET uint32_t laneMask(size_t i) const {
+        __m256i seats = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(capacity + i));
+        __m256i taken = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(participants + i));
+        __m256d hundred = _mm256_set1_pd(100.0);
+        __m256d threshold = _mm256_set1_pd(percent);
+        __m256d lowTaken = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(taken)), hundred);
+        __m256d highTaken = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(taken, 1)), hundred);
+        __m256d lowNeeded = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(seats)), threshold);
+        __m256d highNeeded = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(seats, 1)), threshold);
+        uint32_t low = _mm256_movemask_pd(_mm256_cmp_pd(lowTaken, lowNeeded, _CMP_GE_OQ));
+        uint32_t high = _mm256_movemask_pd(_mm256_cmp_pd(highTaken, highNeeded, _CMP_GE_OQ));
+        return low | (high << 4);
+    }
+#endif
+};
+
+// Fills 'bits' for events [first, count) one event at a time.
+template <typename Filter>
+void scanScalar(const Filter& filter, size_t first, size_t count, uint64_t* bits) {
+    for (size_t word = first / 64; word * 64 < count; word++) {
+        uint64_t mask = 0;
+        size_t end = min(count, word * 64 + 64);
+        for (size_t i = word * 64; i < end; i++) {
+            mask |= static_cast<uint64_t>(filter(i)) << (i % 64);
+        }
+        bits[word] = mask;
+    }
+}
+
+#ifdef UEVENTS_AVX2_KERNELS
+// Fills whole 64-bit words of 'bits' eight events per step, then the tail scalar.
+template <typename Filter>
+AVX2_TARGET void scanAvx2(const Filter& filter, size_t count, uint64_t* bits) {
+    size_t fullWords = count / 64;
+    for (size_t word = 0; word < fullWords; word++) {
+        uint64_t mask = 0;
+        for (size_t lane = 0; lane < 64; lane += 8) {
+            mask |= static_cast<uint64_t>(filter.laneMask(word * 64 + lane)) << lane;
+        }
+        bits[word] = mask;
+    }
+    scanScalar(filter, fullWords * 64, count, bits);
+}
+#endif
+
+// Evaluates 'filter' over every event and returns the selection bitmap.
+template <typename Filter>
+vector<uint64_t> scanEvents(const Filter& filter) {
+    size_t count = eventColumns.size();
+    vector<uint64_t> bits((count + 63) / 64);
+#ifdef UEVENTS_AVX2_KERNELS
+    if (simdKernelsEnabled) {
+        scanAvx2(filter, count, bits.data());
+        return bits;
+    }
+#endif
+    scanScalar(filter, 0, count, bits.data());
+    return bits;
+}
+
+vector<uint64_t> selectEventsOnDate(DayNumber day) {
+    return scanEvents(DateEqualsFilter{eventColumns.date.data(), day});
+}
+
+vector<uint64_t> selectEventsWithFreeSeats(SymbolId department) {
+    return scanEvents(FreeSeatsFilter{eventColumns.department.data(), eventColumns.capacity.data(),
+                                      eventColumns.participants.data(), department});
+}
+
+vector<uint64_t> selectEventsAtOccupancy(int percent) {
+    return scanEvents(OccupancyFilter{eventColumns.capacity.data(), eventColumns.participants.data(), percent});
+}
+
+// Returns the number of events selected in a bitmap.
+size_t countSelected(const vector<uint64_t>& bits) {
+    size_t total = 0;
+    for (uint64_t word : bits) total += popcount64(word);
+    return total;
+}
+
+// Converts a selection bitmap into the handles it selects, in handle (ID) order.
+vector<EventHandle> selectedHandles(const vector<uint64_t>& bits) {
+    vector<EventHandle> handles;
+    handles.reserve(countSelected(bits));
+    for (size_t word = 0; word < bits.size(); word++) {
+        for (uint64_t mask = bits[word]; mask != 0; mask &= mask - 1) {
+            handles.push_back(static_cast<EventHandle>(word * 64 + countTrailingZeros64(mask)));
+        }
+    }
+    return handles;
+}
 
 // Secondary data structures for efficient lookups.
 // These demonstrate proper use of different data structures for specific purposes.
-// Map event name to a pointer to the event in the 'events' vector for O(log N) name lookup.
-map<string, Event*> eventNameMap;
-// Map department name to a vector of pointers to events in that department for O(log N) department lookup.
-map<string, vector<Event*>> eventsByDepartment;
-
-// --- Segment Tree Related Structures and Global Variables ---
-// Map to convert date strings to numerical indices for the segment tree.
-// Ensures O(log K) lookup where K is number of unique dates.
-map<string, int> dateToIndexMap;
-// Vector to convert numerical indices back to date strings.
-// Kept sorted to allow binary search (lower_bound/upper_bound) for range queries.
-vector<string> indexToDateMap;
-// The base array for the segment tree, storing event counts per date index.
-// dateEventCounts[i] holds the number of events on the date represented by index i.
-vector<int> dateEventCounts;
-// The segment tree itself. Stores pre-computed sums for ranges of dateEventCounts.
-// Its size is typically 4 * N (where N is dateEventCounts.size()) for ample space.
-vector<int> segmentTree;
-
-// --- Segment Tree Functions ---
-// These functions implement a basic segment tree for sum queries (counting events).
-
-// Function to build the segment tree recursively.
-// node: current node's index in the segmentTree vector.
-// start: starting index of the current segment in dateEventCounts.
-// end: ending index of the current segment in dateEventCounts.
-void buildSegmentTree(int node, int start, int end) {
-    if (start == end) {
-        // Leaf node: stores the count for a single date.
-        segmentTree[node] = dateEventCounts[start];
-    } else {
-        int mid = (start + end) / 2;
-        // Recursively build left and right children.
-        buildSegmentTree(2 * node, start, mid);        // Left child: 2*node
-        buildSegmentTree(2 * node + 1, mid + 1, end); // Right child: 2*node + 1
-        // Current node stores the sum of its children's values.
-        segmentTree[node] = segmentTree[2 * node] + segmentTree[2 * node + 1];
-    }
-}
-
-// Function to query the sum (count) of events in a given date index range [l, r].
-// node: current node's index in segmentTree.
-// start: starting index of the current segment covered by 'node'.
-// end: ending index of the current segment covered by 'node'.
-// l: left boundary of the query range.
-// r: right boundary of the query range.
-// Returns the total count of events in the queried date range.
-int querySegmentTree(int node, int start, int end, int l, int r) {
-    // Case 1: Query range is completely outside the current segment.
-    // No overlap, so return 0.
-    if (r < start || end < l) {
-        return 0;
-    }
-    // Case 2: Query range completely covers the current segment.
-    // Return the pre-computed sum stored in the current node.
-    if (l <= start && end <= r) {
-        return segmentTree[node];
-    }
-    // Case 3: Partial overlap. Recurse on children and sum their results.
-    int mid = (start + end) / 2;
-    int p1 = querySegmentTree(2 * node, start, mid, l, r);         // Query left child
-    int p2 = querySegmentTree(2 * node + 1, mid + 1, end, l, r); // Query right child
-    return p1 + p2;
-}
-
-// --- Helper Functions for Segment Tree Management ---
-
-// Gathers all unique dates from existing events, maps them to numerical indices,
-// and populates the base array (dateEventCounts) for the segment tree.
-void prepareDateDataForSegmentTree() {
-    set<string> uniqueDates; // Use a set to automatically handle unique and sorted dates
-    for (const auto& event : events) {
-        uniqueDates.insert(event.date);
-    }
-
-    dateToIndexMap.clear();
-    indexToDateMap.clear();
-    int index = 0;
-    for (const string& date : uniqueDates) {
-        dateToIndexMap[date] = index;
-        indexToDateMap.push_back(date);
-        index++;
-    }
-
-    // Initialize dateEventCounts based on current events and their new indices.
-    // This array will be the input for building the segment tree.
-    dateEventCounts.assign(indexToDateMap.size(), 0);
-    for (const auto& event : events) {
-        // Ensure the date is valid and mapped before incrementing count.
-        if (dateToIndexMap.count(event.date)) {
-            dateEventCounts[dateToIndexMap[event.date]]++;
-        }
-    }
-}
-
-// Rebuilds the entire segment tree.
-// This is called when the underlying set of unique dates might have changed
-// (e.g., when adding a new event with a previously unseen date).
-void rebuildSegmentTree() {
-    prepareDateDataForSegmentTree(); // Update date mapping and base counts first
-
-    if (dateEventCounts.empty()) {
-        segmentTree.assign(1, 0); // No dates, tree is effectively empty (size 1, value 0)
-        return;
-    }
-
-    int n = dateEventCounts.size();
-    segmentTree.assign(4 * n, 0); // Allocate enough space for the segment tree
-    buildSegmentTree(1, 0, n - 1); // Build from the root node (1) covering the full range
+// Indexes hold EventHandles rather than Event pointers, so they stay valid across inserts.
+
+// --- Event Name Hash Index ---
+// Exact name lookup in expected O(1): an open-addressing table with linear probing whose
+// 8-byte slots hold the name's 32-bit hash and the event handle. The key is the event's
+// own name in the store, so no second copy of any name is kept, and the stored hash
+// rejects nearly every non-matching slot without touching the string. A lookup is
+// typically one slot-array cache line plus one name comparison. Lookups take a
+// string_view, so callers can probe with any character range. Name order comes from the
+// name trie, not from this table.
+struct EventNameIndex {
+    struct Slot {
+        uint32_t hash;
+        EventHandle handle; // NO_EVENT marks an empty slot
+    };
+    vector<Slot> slots;     // Capacity is zero or a power of two
+    size_t count = 0;
+
+    static uint32_t hashName(string_view name) {
+        return static_cast<uint32_t>(std::hash<string_view>{}(name));
+    }
+
+    void clear() {
+        slots.clear();
+        count = 0;
+    }
+
+    // Sizes the table so 'expected' names fit without further growth.
+    void reserve(size_t expected) {
+        size_t capacity = 16;
+        while (capacity * 7 < expected * 10) capacity *= 2;
+        if (capacity > slots.size()) rehash(capacity);
+    }
+
+    // Returns the handle of the event called 'name', or NO_EVENT.
+    EventHandle find(string_view name) const {
+        if (slots.empty()) return NO_EVENT;
+        uint32_t hash = hashName(name);
+        size_t mask = slots.size() - 1;
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Slot& slot = slots[i];
+            if (slot.handle == NO_EVENT) return NO_EVENT;
+            if (slot.hash == hash && events[slot.handle].name == name) return slot.handle;
+        }
+    }
+
+    bool contains(string_view name) const { return find(name) != NO_EVENT; }
+
+    // Adds the event at 'handle' under its name. The name must not be indexed yet.
+    void insert(EventHandle handle) {
+        if ((count + 1) * 10 > slots.size() * 7) rehash(max<size_t>(16, slots.size() * 2));
+        place({hashName(events[handle].name), handle});
+        count++;
+    }
+
+private:
+    void place(Slot entry) {
+        size_t mask = slots.size() - 1;
+        size_t i = entry.hash & mask;
+        while (slots[i].handle != NO_EVENT) i = (i + 1) & mask;
+        slots[i] = entry;
+    }
+
+    // Moves every entry into a table of 'capacity' slots using the stored hashes.
+    void rehash(size_t capacity) {
+        vector<Slot> old(capacity, Slot{0, NO_EVENT});
+        old.swap(slots);
+        for (const Slot& entry : old) {
+            if (entry.handle != NO_EVENT) place(entry);
+        }
+    }
+};
+
+EventNameIndex eventNameIndex;
+
+// Handles of the events in each department, indexed by department SymbolId, so finding a
+// department's events is an array lookup. Each vector is kept sorted by event name.
+vector<vector<EventHandle>> eventsByDepartment;
+
+// --- Department Name N-gram Index ---
+// Answers "departments whose name contains X" without testing every department name.
+// Each 1-, 2- and 3-byte substring (gram) of a department's name maps to the sorted list
+// of department SymbolIds containing it. A filter of up to 3 bytes is a single
+// posting-list lookup; a longer filter intersects the lists of its trigrams and confirms
+// the few survivors with string::find. Departments are indexed as they are interned.
+unordered_map<uint32_t, vector<SymbolId>> departmentGrams;
+size_t indexedDepartmentCount = 0;
+
+// Packs the 'length' (1-3) bytes at text[offset] with the length, so grams of different
+// lengths never share a key.
+uint32_t packGram(const string& text, size_t offset, size_t length) {
+    uint32_t key = static_cast<uint32_t>(length);
+    for (size_t i = 0; i < length; i++) {
+        key = (key << 8) | static_cast<unsigned char>(text[offset + i]);
+    }
+    return key;
 }
 
-// --- Existing General Helper Functions ---
+// Adds the grams of every department interned since the last call, and gives each one
+// an (empty) event list.
+void indexNewDepartments() {
+    for (; indexedDepartmentCount < departmentPool.size(); indexedDepartmentCount++) {
+        SymbolId id = static_cast<SymbolId>(indexedDepartmentCount);
+        const string& name = departmentPool.text(id);
+        for (size_t length = 1; length <= 3; length++) {
+            for (size_t offset = 0; offset + length <= name.size(); offset++) {
+                vector<SymbolId>& ids = departmentGrams[packGram(name, offset, length)];
+                // Ids only grow, so appending keeps each list sorted; skip repeats within a name.
+                if (ids.empty() || ids.back() != id) ids.push_back(id);
+            }
+        }
+    }
+    eventsByDepartment.resize(departmentPool.size());
+}
 
-// Simple function to center a string within a given width.
-string center(const string& s, int w) {
-    if (s.length() >= w) return s;
-    int padding = (w - s.length()) / 2;
-    return string(padding, ' ') + s + string(w - s.length() - padding, ' ');
+// Rebuilds the n-gram index over every interned department.
+void rebuildDepartmentIndex() {
+    departmentGrams.clear();
+    indexedDepartmentCount = 0;
+    indexNewDepartments();
 }
 
-// Function to update secondary data structures after adding/modifying events.
-// This is a central point for maintaining consistency across all data structures.
-void updateSecondaryDataStructures() {
-    // Clear and repopulate maps for event name and department lookup.
-    eventNameMap.clear();
-    eventsByDepartment.clear();
+// Returns the ids of departments whose name contains 'filter' (which must be non-empty).
+vector<SymbolId> matchDepartments(const string& filter) {
+    static const vector<SymbolId> none;
+    auto postings = [](uint32_t key) -> const vector<SymbolId>& {
+        auto it = departmentGrams.find(key);
+        return it == departmentGrams.end() ? none : it->second;
+    };
+    if (filter.size() <= 3) {
+        return postings(packGram(filter, 0, filter.size()));
+    }
+
+    // Intersect the trigram lists, rarest first, so the candidate set shrinks fastest.
+    vector<const vector<SymbolId>*> lists;
+    for (size_t offset = 0; offset + 3 <= filter.size(); offset++) {
+        lists.push_back(&postings(packGram(filter, offset, 3)));
+    }
+    sort(lists.begin(), lists.end(), [](const vector<SymbolId>* a, const vector<SymbolId>* b) {
+        return a->size() < b->size();
+    });
+    vector<SymbolId> candidates = *lists[0];
+    vector<SymbolId> narrowed;
+    for (size_t i = 1; i < lists.size() && !candidates.empty(); i++) {
+        narrowed.clear();
+        set_intersection(candidates.begin(), candidates.end(), lists[i]->begin(), lists[i]->end(),
+                         back_inserter(narrowed));
+        candidates.swap(narrowed);
+    }
 
-    for (auto& event : events) {
-        eventNameMap[event.name] = &event;
-        eventsByDepartment[event.department].push_back(&event);
-    }
-    // Crucially, rebuild the segment tree data structures after event changes.
-    // This handles cases where new dates are introduced or existing dates gain/lose events.
-    rebuildSegmentTree();
+    // Sharing every trigram does not guarantee they appear in sequence; confirm each one.
+    vector<SymbolId> matches;
+    for (SymbolId id : candidates) {
+        if (departmentPool.text(id).find(filter) != string::npos) matches.push_back(id);
+    }
+    return matches;
 }
 
-// Function to add a new event.
-void addEvent() {
-    clearScreen(); // Clear screen before displaying this option
-    cout << "\n" << string(45, '*') << endl;
-    cout << center("* --- Adding a New UEvent --- *", 45) << endl;
-    cout << string(45, '*') << endl;
-    Event newEvent;
-    // Simple ID generation: 1 if no events, or last event's ID + 1.
-    newEvent.id = events.empty() ? 1 : events.back().id + 1;
-cout << setw(25) << left << "| Event Name:";
-cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer for getline
-getline(cin, newEvent.name);
+// --- Event Name Trie (Prefix and Fuzzy Search) ---
+// A path-compressed trie over all event names, used for autocompletion and for
+// "did you mean" suggestions when a name is mistyped. Nodes live in one vector and link
+// to their first child and next sibling by index; siblings are kept ordered by their
+// first byte, so a depth-first walk visits names in sorted order. Edge labels are slices
+// of one contiguous byte arena, so walking an edge never leaves the trie's own memory;
+// splitting an edge just shortens one slice. N names need at most 2N nodes of 24 bytes
+// plus, in the arena, each name's bytes past the prefix it shares with earlier names.
+const uint32_t NO_TRIE_NODE = UINT32_MAX;
 
-// Check if event name already exists using map for efficiency.
-if (eventNameMap.count(newEvent.name)) {
-cout << "\n⚠️ UEvent with name '" << newEvent.name << "' already exists. Please choose a different name. ⚠️" << endl;
-        return;
- }
-
-    cout << setw(25) << left << "| Date (YYYY-MM-DD):";
-    cin >> newEvent.date;
-    cout << setw(25) << left << "| Start Time (HH:MM):"; // NEW input for start time
-    cin >> newEvent.startTime;
-    cout << setw(25) << left << "| End Time (HH:MM):";   // NEW input for end time
-    cin >> newEvent.endTime;
-    
-    cout << setw(25) << left << "| Location:";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer for getline
-    getline(cin, newEvent.location);
-    cout << setw(25) << left << "| Department:";
-    getline(cin, newEvent.department);
-    cout << setw(25) << left << "| Capacity:";
-    // Input validation for capacity
-    while (!(cin >> newEvent.capacity) || newEvent.capacity <= 0) {
-        cout << "Invalid capacity. Please enter a positive integer: ";
-        cin.clear();
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    }
-    newEvent.participants = 0; // New events start with 0 participants.
-    newEvent.registeredParticipants.clear(); // Initialize empty list
-    cout << string(45, '*') << endl;
-
-    events.push_back(newEvent);
-    // Maintain sorted order of the primary 'events' vector by name.
-    sort(events.begin(), events.end());
-
-    // Update all secondary data structures and the segment tree.
-    updateSecondaryDataStructures();
-
-    cout << "\nUEvent '" << newEvent.name << "' added successfully! ✨" << endl;
+struct TrieNode {
+    uint32_t labelOffset;     // Label start in nameTrieLabels
+    uint32_t labelLength;     // Label length (0 only for the root)
+    char firstByte;           // Copy of the label's first byte, for scanning siblings
+    uint32_t firstChild;
+    uint32_t nextSibling;
+    EventHandle handle;       // Event whose name ends at this node, or NO_EVENT
+};
+
+vector<TrieNode> nameTrie;
+vector<char> nameTrieLabels;
+
+// Returns byte i of the node's edge label.
+char trieLabelAt(const TrieNode& node, uint32_t i) {
+    return nameTrieLabels[node.labelOffset + i];
 }
 
-// Function to display events (reusable for different lists of events).
-void displayEventsList(const vector<Event*>& eventList, const string& title) {
-    cout << "\n" << string(109, '=') << endl; // Increased width for new time columns
-    cout << center("✨ --- " + title + " --- ✨", 109) << endl;
-    cout << string(109, '=') << endl;
-    if (eventList.empty()) {
-        cout << center("No UEvents available. 😔", 109) << endl;
-        cout << string(109, '=') << endl;
-        return;
-    }
-    // Table header formatting.
-    cout << setw(5) << left << "ID" << " | "
-         << setw(20) << left << "Name" << " | "
-         << setw(12) << left << "Date" << " | "
-         << setw(9) << left << "Start" << " | " // NEW header for start time
-         << setw(9) << left << "End" << " | "   // NEW header for end time
-         << setw(15) << left << "Location" << " | "
-         << setw(15) << left << "Department" << " | "
-         << setw(10) << right << "Capacity" << " | "
-         << setw(12) << right << "Participants" << endl;
-    cout << string(109, '-') << endl;
-    // Iterate and display each event using pointers.
-    for (const auto& eventPtr : eventList) {
-        const auto& event = *eventPtr; // Dereference pointer to access Event members.
-        cout << setw(5) << left << event.id << " | "
-             << setw(20) << left << event.name << " | "
-             << setw(12) << left << event.date << " | "
-             << setw(9) << left << event.startTime << " | " // Display start time
-             << setw(9) << left << event.endTime << " | "   // Display end time
-             << setw(15) << left << event.location << " | "
-             << setw(15) << left << event.department << " | "
-             << setw(10) << right << event.capacity << " | "
-             << setw(12) << right << event.participants << endl;
-    }
-    cout << string(109, '=') << endl;
-    cout << endl;
-}
-
-// Function to display all events, leveraging the primary sorted vector.
-void displayAllEvents() {
-    clearScreen(); // Clear screen before displaying this option
-    vector<Event*> allEventsPtrs;
-    // Populate a vector of pointers to display all events.
-    for(auto& event : events) {
-        allEventsPtrs.push_back(&event);
-    }
-    displayEventsList(allEventsPtrs, "All UEvents (Sorted by Name)");
+// Empties the trie, leaving only the root.
+void clearNameTrie() {
+    nameTrie.clear();
+    nameTrieLabels.clear();
+    nameTrie.push_back({0, 0, '\0', NO_TRIE_NODE, NO_TRIE_NODE, NO_EVENT});
 }
 
-// Function to search for an event by name using std::map for efficient O(log N) search.
-void searchEvent() {
-    clearScreen(); // Clear screen before displaying this option
-    cout << "\n" << string(45, '*') << endl;
-    cout << center("* --- Search for a UEvent --- *", 45) << endl;
-    cout << string(45, '*') << endl;
-    cout << setw(30) << left << "| Enter UEvent name to search:";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    string searchName;
-    getline(cin, searchName);
-    cout << string(45, '*') << endl;
-
-    auto it = eventNameMap.find(searchName); // O(log N) map lookup.
-    if (it != eventNameMap.end()) {
-        cout << "\n✨ UEvent Found! ✨" << endl;
-        vector<Event*> foundEvent = {it->second}; // Found event, put into a vector for display.
-        displayEventsList(foundEvent, "Search Result for '" + searchName + "'");
-    } else {
-        cout << "\nUEvent '" << searchName << "' not found. 😔" << endl;
-    }
-    cout << endl;
+// Adds the name of the event at 'handle' to the trie. O(name length x branching).
+void addToNameTrie(EventHandle handle) {
+    const string& name = events[handle].name;
+    uint32_t node = 0;
+    uint32_t depth = 0;
+    while (depth < name.size()) {
+        unsigned char c = name[depth];
+        // Find the child starting with c, or the sibling it should be linked after.
+        uint32_t previous = NO_TRIE_NODE;
+        uint32_t child = nameTrie[node].firstChild;
+        while (child != NO_TRIE_NODE && static_cast<unsigned char>(nameTrie[child].firstByte) < c) {
+            previous = child;
+            child = nameTrie[child].nextSibling;
+        }
+        if (child == NO_TRIE_NODE || static_cast<unsigned char>(nameTrie[child].firstByte) != c) {
+            // No edge shares the next byte: the rest of the name becomes one new leaf.
+            uint32_t leaf = static_cast<uint32_t>(nameTrie.size());
+            nameTrie.push_back({static_cast<uint32_t>(nameTrieLabels.size()), static_cast<uint32_t>(name.size()) - depth,
+                                name[depth], NO_TRIE_NODE, child, handle});
+            nameTrieLabels.insert(nameTrieLabels.end(), name.begin() + depth, name.end());
+            if (previous == NO_TRIE_NODE) {
+                nameTrie[node].firstChild = leaf;
+            } else {
+                nameTrie[previous].nextSibling = leaf;
+            }
+            return;
+        }
+
+        uint32_t common = 1;
+        uint32_t labelLength = nameTrie[child].labelLength;
+        while (common < labelLength && depth + common < name.size() &&
+               trieLabelAt(nameTrie[child], common) == name[depth + common]) {
+            common++;
+        }
+        if (common < labelLength) {
+            // The name leaves this edge part-way: split it, moving the remainder of the
+            // label (with the old children and event) into a new node below.
+            TrieNode tail = nameTrie[child];
+            tail.labelOffset += common;
+            tail.labelLength -= common;
+            tail.firstByte = trieLabelAt(tail, 0);
+            tail.nextSibling = NO_TRIE_NODE;
+            uint32_t tailIndex = static_cast<uint32_t>(nameTrie.size());
+            nameTrie.push_back(tail);
+            nameTrie[child].labelLength = common;
+            nameTrie[child].firstChild = tailIndex;
+            nameTrie[child].handle = NO_EVENT;
+        }
+        node = child;
+        depth += common;
+    }
+    nameTrie[node].handle = handle;
 }
 
-// Function to register a participant for an event.
-// Uses eventNameMap for quick event lookup.
-void registerParticipant() {
-    clearScreen(); // Clear screen before displaying this option
-    cout << "\n" << string(45, '*') << endl;
-    cout << center("* --- Register for a UEvent --- *", 45) << endl;
-    cout << string(45, '*') << endl;
-    cout << setw(30) << left << "| Enter the name of the UEvent:";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    string eventName;
-    getline(cin, eventName);
-    cout << string(45, '*') << endl;
-
-    auto it = eventNameMap.find(eventName); // O(log N) event lookup.
-    if (it != eventNameMap.end()) {
-        Event* eventPtr = it->second;
-        if (eventPtr->participants < eventPtr->capacity) {
-            Participant newParticipant;
-            cout << setw(30) << left << "| Enter participant's Name:";
-            getline(cin, newParticipant.name); // Using getline for names with spaces
-            cout << setw(30) << left << "| Enter participant's Course:";
-            getline(cin, newParticipant.course); // Using getline for courses with spaces
-
-            eventPtr->registeredParticipants.push_back(newParticipant); // Add participant to event
-            eventPtr->participants++; // Increment the count of participants
-
-            cout << "🎉 Successfully registered '" << newParticipant.name << "' from " << newParticipant.course
-                 << " for '" << eventPtr->name << "'! 🎉" << endl;
-        } else {
-            cout << "⚠️ UEvent '" << eventPtr->name << "' is already full. 😟" << endl;
-        }
-    } else {
-        cout << "UEvent '" << eventName << "' not found. 😔" << endl;
-    }
-    cout << endl;
+// Appends events under 'node' to 'out' in name order until 'out' holds 'limit' entries.
+void collectTrieNames(uint32_t node, size_t limit, vector<EventHandle>& out) {
+    if (out.size() >= limit) return;
+    if (nameTrie[node].handle != NO_EVENT) out.push_back(nameTrie[node].handle);
+    for (uint32_t child = nameTrie[node].firstChild; child != NO_TRIE_NODE; child = nameTrie[child].nextSibling) {
+        collectTrieNames(child, limit, out);
+    }
 }
 
-// Function to display events based on a specific department.
-// Uses eventsByDepartment map for efficient departmental grouping.
-void displayEventsByDepartment() {
-    clearScreen(); // Clear screen before displaying this option
-    cout << "\n" << string(45, '*') << endl;
-    cout << center("* --- UEvents by Department --- *", 45) << endl;
-    cout << string(45, '*') << endl;
-    cout << setw(30) << left << "| Enter the department to filter by:";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    string filterDepartment;
-    getline(cin, filterDepartment);
-    cout << string(45, '*') << endl;
-
-    vector<Event*> filteredEvents;
-    // Iterate through all departments in the map.
-    for (const auto& pair : eventsByDepartment) {
-        // Use string::find for partial match in department names.
-        if (pair.first.find(filterDepartment) != string::npos) {
-            // Append all events from this matching department.
-            for(Event* eventPtr : pair.second) { // pair.second is vector<Event*>
-                filteredEvents.push_back(eventPtr);
-            }
-        }
-    }
-
-    if (filteredEvents.empty()) {
-        cout << "No UEvents found with department containing '" << filterDepartment << "'. 😔" << endl;
-    } else {
-        // Sort results by name for consistent display, even if collected from map.
-        // Uses a lambda for custom comparison with pointers.
-        sort(filteredEvents.begin(), filteredEvents.end(), [](Event* a, Event* b) {
-            return a->name < b->name;
-        });
-        displayEventsList(filteredEvents, "UEvents with department containing '" + filterDepartment + "'");
-    }
-    cout << endl;
+// Returns up to 'limit' events whose names start with 'prefix', in name order.
+// Costs O(prefix length + limit) node visits, independent of the number of events.
+vector<EventHandle> completeEventName(const string& prefix, size_t limit) {
+    vector<EventHandle> matches;
+    uint32_t node = 0;
+    size_t depth = 0;
+    while (depth < prefix.size()) {
+        uint32_t child = nameTrie[node].firstChild;
+        while (child != NO_TRIE_NODE && nameTrie[child].firstByte != prefix[depth]) {
+            child = nameTrie[child].nextSibling;
+        }
+        if (child == NO_TRIE_NODE) return matches;
+        const TrieNode& edge = nameTrie[child];
+        for (uint32_t i = 0; i < edge.labelLength && depth < prefix.size(); i++, depth++) {
+            if (trieLabelAt(edge, i) != prefix[depth]) return matches;
+        }
+        node = child;
+    }
+    collectTrieNames(node, limit, matches);
+    return matches;
+}
+
+// Returns every event in name order: a full walk of the trie.
+vector<EventHandle> eventsInNameOrder() {
+    vector<EventHandle> all;
+    all.reserve(events.size());
+    collectTrieNames(0, SIZE_MAX, all);
+    return all;
+}
+
+// Calls 'visit' for every event under 'node' in name order, without collecting them.
+template <typename Visit>
+void forEachEventInNameOrder(uint32_t node, Visit&& visit) {
+    if (nameTrie[node].handle != NO_EVENT) visit(nameTrie[node].handle);
+    for (uint32_t child = nameTrie[node].firstChild; child != NO_TRIE_NODE; child = nameTrie[child].nextSibling) {
+        forEachEventInNameOrder(child, visit);
+    }
+}
+
+// Walks the trie computing one Levenshtein DP row per label byte against 'query'
+// (already lower-cased; the label is lower-cased as it is read), abandoning any branch
+// whose best cell already exceeds 'maxDistance'. rows holds one (query.size() + 1)-wide
+// row per depth. Only the diagonal band |depth - j| <= maxDistance can stay within the
+// bound, so only those cells are computed; the cells just outside it hold maxDistance + 1.
+void fuzzyTrieWalk(uint32_t node, size_t depth, const string& query, int maxDistance, vector<int>& rows,
+                   vector<pair<int, EventHandle>>& matches) {
+    const size_t width = query.size() + 1;
+    const size_t band = static_cast<size_t>(maxDistance);
+    const int outside = maxDistance + 1;
+    const TrieNode& current = nameTrie[node];
+    for (uint32_t i = 0; i < current.labelLength; i++) {
+        depth++;
+        if (rows.size() < (depth + 1) * width) rows.resize((depth + 1) * width);
+        const int* above = &rows[(depth - 1) * width];
+        int* row = &rows[depth * width];
+        char c = static_cast<char>(tolower(static_cast<unsigned char>(trieLabelAt(current, i))));
+        size_t low = depth > band ? depth - band : 1;
+        size_t high = min(query.size(), depth + band);
+        row[low - 1] = low == 1 ? min(static_cast<int>(depth), outside) : outside;
+        int best = row[low - 1];
+        for (size_t j = low; j <= high; j++) {
+            int substitute = above[j - 1] + (query[j - 1] == c ? 0 : 1);
+            row[j] = min({above[j] + 1, row[j - 1] + 1, substitute, outside});
+            best = min(best, row[j]);
+        }
+        if (high + 1 < width) row[high + 1] = outside;
+        if (best > maxDistance) return;
+    }
+    // The last column is only meaningful while it lies inside (or just beside) the band.
+    if (current.handle != NO_EVENT && query.size() <= depth + band) {
+        int distance = rows[depth * width + query.size()];
+        if (distance <= maxDistance) matches.push_back({distance, current.handle});
+    }
+    for (uint32_t child = current.firstChild; child != NO_TRIE_NODE; child = nameTrie[child].nextSibling) {
+        fuzzyTrieWalk(child, depth, query, maxDistance, rows, matches);
+    }
+}
+
+// Returns up to 'limit' events whose names are within 'maxDistance' edits (insertions,
+// deletions, substitutions; case is ignored) of 'query', closest first, ties in name order.
+// The bound is raised one edit at a time and the search stops as soon as 'limit' matches
+// are found: the neighbourhood grows steeply with the bound, and closer matches rank
+// first anyway, so a wider walk could not change the answer.
+vector<EventHandle> fuzzyFindEventNames(const string& query, int maxDistance, size_t limit) {
+    string lowered = query;
+    for (char& c : lowered) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    vector<int> rows(query.size() + 1);
+    vector<pair<int, EventHandle>> matches;
+    for (int bound = 0; bound <= maxDistance; bound++) {
+        for (size_t j = 0; j <= query.size(); j++) rows[j] = min(static_cast<int>(j), bound + 1);
+        matches.clear();
+        fuzzyTrieWalk(0, 0, lowered, bound, rows, matches);
+        if (matches.size() >= limit) break;
+    }
+    // The walk is in name order, so a stable sort by distance keeps ties alphabetical.
+    stable_sort(matches.begin(), matches.end(),
+                [](const pair<int, EventHandle>& a, const pair<int, EventHandle>& b) { return a.first < b.first; });
+    vector<EventHandle> result;
+    for (size_t i = 0; i < matches.size() && i < limit; i++) {
+        result.push_back(matches[i].second);
+    }
+    return result;
+}
+
+// Names to offer when 'name' matches no event: close misspellings first (one edit for
+// short names, two otherwise), then completions of what was typed.
+vector<EventHandle> suggestEventNames(const string& name, size_t limit) {
+    vector<EventHandle> suggestions = fuzzyFindEventNames(name, name.size() <= 4 ? 1 : 2, limit);
+    if (!name.empty() && suggestions.size() < limit) {
+        for (EventHandle handle : completeEventName(name, limit)) {
+            if (suggestions.size() >= limit) break;
+            if (find(suggestions.begin(), suggestions.end(), handle) == suggestions.end()) {
+                suggestions.push_back(handle);
+            }
+        }
+    }
+    return suggestions;
+}
+
+// --- Fenwick Tree (Binary Indexed Tree) over Day Numbers ---
+// Counts events per day over the whole supported calendar window, so a date never
+// needs to be "registered" before use: adding an event on any valid day is a single
+// O(log D) point update, and counting a date range is two O(log D) prefix sums.
+// dateFenwick is 1-based: position day + 1 holds the partial sum for that day.
+vector<int> dateFenwick;
+
+// Adds 'delta' to the event count of the given day.
+void fenwickAdd(DayNumber day, int delta) {
+    for (int i = day + 1; i <= DAY_RANGE; i += i & -i) {
+        dateFenwick[i] += delta;
+    }
+}
+
+// Returns the number of events on days [0, day].
+int fenwickPrefixSum(DayNumber day) {
+    int sum = 0;
+    for (int i = day + 1; i > 0; i -= i & -i) {
+        sum += dateFenwick[i];
+    }
+    return sum;
+}
+
+// Returns the number of events with first <= date <= last.
+int countEventsInDayRange(DayNumber first, DayNumber last) {
+    if (first > last) {
+        return 0;
+    }
+    return fenwickPrefixSum(last) - (first > 0 ? fenwickPrefixSum(first - 1) : 0);
+}
+
+// Rebuilds the Fenwick tree from all stored events in O(N + D).
+// Per-day counts are written to their own positions first, then each position
+// pushes its total up to its parent once.
+void rebuildDateIndex() {
+    dateFenwick.assign(DAY_RANGE + 1, 0);
+    for (EventHandle h = 0; h < events.size(); h++) {
+        dateFenwick[events[h].date + 1]++;
+    }
+    for (int i = 1; i <= DAY_RANGE; i++) {
+        int parent = i + (i & -i);
+        if (parent <= DAY_RANGE) {
+            dateFenwick[parent] += dateFenwick[i];
+        }
+    }
+}
+
+// --- Date-Ordered Event Buckets ---
+// Secondary index mapping each day that has events to the handles of those events,
+// kept sorted by start time (then name) within the day. Together the buckets form a
+// permanently maintained (date, startTime) ordering of all events, updated on insert.
+// Walking the map from lower_bound(first) visits only the days inside a range, so
+// listing a short window over a long calendar touches only the matching events, and
+// listing everything by date is a plain walk with no sorting.
+map<DayNumber, vector<EventHandle>> eventsByDate;
+
+// Orders events within a day bucket: by start time, then by name.
+bool startsBefore(EventHandle a, EventHandle b) {
+    const Event& first = events[a];
+    const Event& second = events[b];
+    if (first.startTime != second.startTime) return first.startTime < second.startTime;
+    return first.name < second.name;
+}
+
+// Position in the date-ordered walk over all events.
+struct DateOrderCursor {
+    map<DayNumber, vector<EventHandle>>::const_iterator day;
+    size_t position = 0;
+};
+
+// Returns a cursor at the earliest event.
+DateOrderCursor dateOrderBegin() {
+    return {eventsByDate.begin(), 0};
+}
+
+// Returns up to 'limit' events following the cursor in (date, startTime) order and
+// advances the cursor past them. Costs O(limit), however large the calendar is.
+vector<EventHandle> nextDateOrderPage(DateOrderCursor& cursor, size_t limit) {
+    vector<EventHandle> page;
+    while (page.size() < limit && cursor.day != eventsByDate.end()) {
+        const vector<EventHandle>& bucket = cursor.day->second;
+        while (page.size() < limit && cursor.position < bucket.size()) {
+            page.push_back(bucket[cursor.position++]);
+        }
+        if (cursor.position == bucket.size()) {
+            ++cursor.day;
+            cursor.position = 0;
+        }
+    }
+    return page;
+}
+
+// Returns the handles of events with first <= date <= last in (date, startTime) order,
+// skipping the first 'offset' matches and returning at most 'limit'.
+// Whole days before the offset are skipped by their bucket size, without visiting events.
+vector<EventHandle> queryEventsInDateRange(DayNumber first, DayNumber last, size_t offset, size_t limit) {
+    vector<EventHandle> page;
+    for (auto it = eventsByDate.lower_bound(first); it != eventsByDate.end() && it->first <= last; ++it) {
+        const vector<EventHandle>& bucket = it->second;
+        if (offset >= bucket.size()) {
+            offset -= bucket.size();
+            continue;
+        }
+        for (size_t i = offset; i < bucket.size() && page.size() < limit; i++) {
+            page.push_back(bucket[i]);
+        }
+        offset = 0;
+        if (page.size() == limit) {
+            break;
+        }
+    }
+    return page;
+}
+
+// --- Booking Conflict Index ---
+// Events booked at the same location on the same day, kept sorted by start time.
+// maxDuration is the longest booking in the list: any booking overlapping a time
+// window must start less than maxDuration minutes before the window begins, which
+// bounds the part of the list that has to be examined.
+struct LocationDaySchedule {
+    vector<EventHandle> byStart;
+    int maxDuration = 0;
+};
+
+// Map (location id, day) to the bookings at that location on that day.
+map<pair<SymbolId, DayNumber>, LocationDaySchedule> schedulesByLocationDay;
+
+// Adds an event to a location/day schedule at its sorted position.
+void addToSchedule(LocationDaySchedule& schedule, EventHandle handle) {
+    const Event& event = events[handle];
+    auto pos = upper_bound(schedule.byStart.begin(), schedule.byStart.end(), handle,
+                           [](EventHandle a, EventHandle b) { return events[a].startTime < events[b].startTime; });
+    schedule.byStart.insert(pos, handle);
+    schedule.maxDuration = max(schedule.maxDuration, event.endTime - event.startTime);
+}
+
+// Adds an event to the schedule of its location and day.
+void addToSchedule(EventHandle handle) {
+    const Event& event = events[handle];
+    addToSchedule(schedulesByLocationDay[{event.location, event.date}], handle);
+}
+
+// Appends the events in 'schedule' whose time overlaps [start, end) to 'conflicts'.
+// Binary searches for bookings starting in (start - maxDuration, end), so the cost is
+// O(log N + k) where k is the number of bookings starting in that window.
+void findBookingConflicts(const LocationDaySchedule& schedule, MinuteOfDay start, MinuteOfDay end,
+                          vector<EventHandle>& conflicts) {
+    int earliestStart = start - schedule.maxDuration;
+    auto first = upper_bound(schedule.byStart.begin(), schedule.byStart.end(), earliestStart,
+                             [](int value, EventHandle h) { return value < events[h].startTime; });
+    for (auto pos = first; pos != schedule.byStart.end() && events[*pos].startTime < end; ++pos) {
+        if (events[*pos].endTime > start) {
+            conflicts.push_back(*pos);
+        }
+    }
+}
+
+// Returns the handles of events at 'location' on 'day' whose time overlaps [start, end).
+vector<EventHandle> findBookingConflicts(SymbolId location, DayNumber day, MinuteOfDay start, MinuteOfDay end) {
+    vector<EventHandle> conflicts;
+    auto it = schedulesByLocationDay.find({location, day});
+    if (it != schedulesByLocationDay.end()) {
+        findBookingConflicts(it->second, start, end, conflicts);
+    }
+    return conflicts;
+}
+
+// Finds every pair of overlapping bookings across all locations and days.
+// Each schedule is swept once in start-time order while keeping the bookings that are
+// still running; a new booking conflicts with exactly those. Runs in O(N + K) over the
+// already-sorted schedules, where K is the number of conflicting pairs reported.
+vector<pair<EventHandle, EventHandle>> findAllBookingConflicts() {
+    vector<pair<EventHandle, EventHandle>> conflicts;
+    vector<EventHandle> running;
+    for (const auto& entry : schedulesByLocationDay) {
+        running.clear();
+        for (EventHandle handle : entry.second.byStart) {
+            MinuteOfDay start = events[handle].startTime;
+            // Drop bookings that ended at or before this one starts.
+            running.erase(remove_if(running.begin(), running.end(),
+                                    [start](EventHandle h) { return events[h].endTime <= start; }),
+                          running.end());
+            for (EventHandle other : running) {
+                conflicts.push_back({other, handle});
+            }
+            running.push_back(handle);
+        }
+    }
+    return conflicts;
+}
+
+// --- Worker Pool ---
+// A fixed set of worker threads for fork/join parallel loops. parallelFor() publishes a
+// job, lets the workers and the calling thread claim loop indices from a shared atomic
+// counter, and returns once every index has run. The job is passed as a plain function
+// pointer plus context, so dispatching work performs no heap allocation.
+struct WorkerPool {
+    vector<thread> workers;
+    mutex dispatchLock; // Serialises parallelFor() callers
+    mutex lock;         // Guards the fields below
+    condition_variable wake, done;
+    void (*job)(void*, size_t) = nullptr;
+    void* context = nullptr;
+    size_t jobSize = 0;
+    atomic<size_t> nextIndex{0};
+    size_t pendingWorkers = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+
+    explicit WorkerPool(size_t workerCount) {
+        for (size_t i = 0; i < workerCount; i++) {
+            workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& worker : workers) worker.join();
+    }
+
+    // Number of threads that execute a parallelFor(), including the caller.
+    size_t threadCount() const { return workers.size() + 1; }
+
+    // Runs body(i) for every i in [0, count) across the pool and waits for completion.
+    template <typename F>
+    void parallelFor(size_t count, F& body) {
+        if (workers.empty() || count <= 1) {
+            for (size_t i = 0; i < count; i++) body(i);
+            return;
+        }
+        lock_guard<mutex> dispatchGuard(dispatchLock);
+        {
+            lock_guard<mutex> guard(lock);
+            job = [](void* ctx, size_t i) { (*static_cast<F*>(ctx))(i); };
+            context = &body;
+            jobSize = count;
+            nextIndex = 0;
+            pendingWorkers = workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        runJob();
+        unique_lock<mutex> guard(lock);
+        done.wait(guard, [this]() { return pendingWorkers == 0; });
+    }
+
+private:
+    void runJob() {
+        for (size_t i = nextIndex.fetch_add(1); i < jobSize; i = nextIndex.fetch_add(1)) {
+            job(context, i);
+        }
+    }
+
+    void workerLoop() {
+        uint64_t seenGeneration = 0;
+        unique_lock<mutex> guard(lock);
+        while (true) {
+            wake.wait(guard, [&]() { return stopping || generation != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = generation;
+            guard.unlock();
+            runJob();
+            guard.lock();
+            if (--pendingWorkers == 0) done.notify_one();
+        }
+    }
+};
+
+// Shared pool sized to the machine (the calling thread is the extra worker).
+WorkerPool& sharedWorkerPool() {
+    static WorkerPool pool(max(1u, thread::hardware_concurrency()) - 1);
+    return pool;
 }
 
 // --- Merge Sort Implementation ---
+// Stable bottom-up merge sort that ping-pongs between the data and one caller-provided
+// scratch buffer of the same size, so no memory is allocated while sorting. Runs shorter
+// than INSERTION_SORT_CUTOFF are sorted by insertion sort first.
+//
+// The parallel version sorts one block per pool thread concurrently, then merges blocks
+// level by level. Every merge is cut into equal slices of output with a "merge path"
+// binary search, so even the final merge of two halves is spread across all threads.
 
-// Merges two sorted sub-arrays eventList[left..mid] and eventList[mid+1..right]
-void merge(vector<Event*>& eventList, int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-
-    // Create temporary vectors to hold the two halves
-    vector<Event*> L(n1);
-    vector<Event*> R(n2);
-
-    // Copy data to temp vectors L[] and R[]
-    for (int i = 0; i < n1; i++) {
-        L[i] = eventList[left + i];
-    }
-    for (int j = 0; j < n2; j++) {
-        R[j] = eventList[mid + 1 + j];
-    }
-
-    // Merge the temporary vectors back into eventList[left..right]
-    int i = 0; // Initial index of first sub-array
-    int j = 0; // Initial index of second sub-array
-    int k = left; // Initial index of merged sub-array
-
-    while (i < n1 && j < n2) {
-        // Compare dates lexicographically (YYYY-MM-DD format allows direct string comparison)
-        if (L[i]->date <= R[j]->date) {
-            eventList[k] = L[i];
-            i++;
-        } else {
-            eventList[k] = R[j];
-            j++;
-        }
-        k++;
-    }
-
-    // Copy the remaining elements of L[], if any
-    while (i < n1) {
-        eventList[k] = L[i];
-        i++;
-        k++;
-    }
-
-    // Copy the remaining elements of R[], if any
-    while (j < n2) {
-        eventList[k] = R[j];
-        j++;
-        k++;
-    }
-}
-
-// Recursive function to perform Merge Sort on eventList[left..right]
-void mergeSortEventsByDate(vector<Event*>& eventList, int left, int right) {
-    if (left >= right) { // Base case: array with 0 or 1 element is sorted
-        return;
-    }
-    int mid = left + (right - left) / 2; // Avoid potential overflow compared to (left+right)/2
-    mergeSortEventsByDate(eventList, left, mid);       // Sort first half
-    mergeSortEventsByDate(eventList, mid + 1, right); // Sort second half
-    merge(eventList, left, mid, right);               // Merge the sorted halves
-}
-
-
-// Function to display events sorted by date using Merge Sort.
-void displayEventsSortedByDate() {
-    clearScreen(); // Clear screen before displaying this option
-    if (events.empty()) {
-        cout << "\n" << string(109, '=') << endl; // Increased width
-        cout << center("No UEvents available to sort. 😔", 109) << endl;
-        cout << string(109, '=') << endl;
-        return;
-    }
+// Runs at or below this length are sorted with insertion sort.
+const size_t INSERTION_SORT_CUTOFF = 32;
+// Inputs shorter than this are sorted on the calling thread only.
+const size_t PARALLEL_SORT_THRESHOLD = 1 << 15;
 
-    // Create a copy of pointers to events to sort.
-    // This ensures the main 'events' vector (sorted by name) is not altered.
-    vector<Event*> eventsCopy;
-    for(auto& event : events) {
-        eventsCopy.push_back(&event);
-    }
+// Stable insertion sort of [first, last).
+template <typename T, typename Less>
+void insertionSortRange(T* first, T* last, Less less) {
+    for (T* i = first + 1; i < last; i++) {
+        T value = *i;
+        T* j = i;
+        for (; j > first && less(value, j[-1]); j--) {
+            *j = j[-1];
+        }
+        *j = value;
+    }
+}
 
-    // Apply Merge Sort on the copy.
-    mergeSortEventsByDate(eventsCopy, 0, eventsCopy.size() - 1);
+// Stable merge of a[0..aSize) and b[0..bSize) into out; ties are taken from 'a'.
+template <typename T, typename Less>
+void mergeRuns(const T* a, size_t aSize, const T* b, size_t bSize, T* out, Less less) {
+    size_t i = 0, j = 0;
+    while (i < aSize && j < bSize) {
+        *out++ = less(b[j], a[i]) ? b[j++] : a[i++];
+    }
+    out = copy(a + i, a + aSize, out);
+    copy(b + j, b + bSize, out);
+}
 
-    displayEventsList(eventsCopy, "UEvents Sorted by Date (Merge Sort)");
+// Returns how many elements of 'a' come before output position 'k' when merging a and b
+// stably (the "merge path" split); the remaining k - result come from 'b'.
+template <typename T, typename Less>
+size_t mergePathSplit(const T* a, size_t aSize, const T* b, size_t bSize, size_t k, Less less) {
+    size_t low = k > bSize ? k - bSize : 0;
+    size_t high = min(k, aSize);
+    while (low < high) {
+        size_t i = (low + high) / 2; // Candidate count taken from 'a'
+        if (!less(b[k - i - 1], a[i])) {
+            low = i + 1; // a[i] must precede b[k - i - 1]
+        } else {
+            high = i;
+        }
+    }
+    return low;
 }
 
-// Linear Search implementation (second searching algorithm demonstrated).
-// Searches for all events on a specific date.
-void searchEventsByDate() {
-    clearScreen(); // Clear screen before displaying this option
-    cout << "\n" << string(45, '*') << endl;
-    cout << center("* --- Search UEvents by Date --- *", 45) << endl;
-    cout << string(45, '*') << endl;
-    cout << setw(30) << left << "| Enter date (YYYY-MM-DD) to search:";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    string searchDate;
-    getline(cin, searchDate);
-    cout << string(45, '*') << endl;
-
-    vector<Event*> foundEvents;
-    // Perform a linear search through all events.
-    for (auto& event : events) {
-        if (event.date == searchDate) {
-            foundEvents.push_back(&event);
-        }
-    }
-
-    if (foundEvents.empty()) {
-        cout << "\nNo UEvents found on '" << searchDate << "'. 😔" << endl;
-    } else {
-        cout << "\n✨ UEvents found on '" << searchDate << "'! ✨" << endl;
-        // Sort results by name for consistent display.
-        sort(foundEvents.begin(), foundEvents.end(), [](Event* a, Event* b) {
-            return a->name < b->name;
-        });
-        displayEventsList(foundEvents, "UEvents on " + searchDate);
-    }
-    cout << endl;
-}
-
-
-// --- New Function: Query Events by Date Range (using Segment Tree) ---
-// This function demonstrates the efficiency of the Segment Tree for range queries.
-void queryEventsByDateRange() {
-    clearScreen(); // Clear screen before displaying this option
-    cout << "\n" << string(45, '*') << endl;
-    cout << center("* --- Count UEvents by Date Range --- *", 45) << endl;
-    cout << string(45, '*') << endl;
+// Sorts data[0..n) on the calling thread, leaving the result in 'data'.
+template <typename T, typename Less>
+void sequentialMergeSort(T* data, T* scratch, size_t n, Less less) {
+    for (size_t start = 0; start < n; start += INSERTION_SORT_CUTOFF) {
+        insertionSortRange(data + start, data + min(n, start + INSERTION_SORT_CUTOFF), less);
+    }
+    T* source = data;
+    T* target = scratch;
+    for (size_t width = INSERTION_SORT_CUTOFF; width < n; width *= 2) {
+        for (size_t start = 0; start < n; start += 2 * width) {
+            size_t mid = min(n, start + width);
+            size_t end = min(n, start + 2 * width);
+            mergeRuns(source + start, mid - start, source + mid, end - mid, target + start, less);
+        }
+        swap(source, target);
+    }
+    if (source != data) {
+        copy(source, source + n, data);
+    }
+}
 
-    if (indexToDateMap.empty() || segmentTree.empty()) {
-        cout << "No events available to query by date. 😔" << endl;
-        cout << string(45, '*') << endl;
-        return;
-    }
+// Stable parallel merge sort of 'items' using 'scratch' (resized to fit if needed; no
+// allocation happens once it is large enough).
+template <typename T, typename Less>
+void parallelMergeSort(vector<T>& items, vector<T>& scratch, Less less, WorkerPool& pool) {
+    const size_t n = items.size();
+    if (scratch.size() < n) {
+        scratch.resize(n);
+    }
+    if (n < PARALLEL_SORT_THRESHOLD || pool.threadCount() == 1) {
+        sequentialMergeSort(items.data(), scratch.data(), n, less);
+        return;
+    }
 
-    cout << setw(30) << left << "| Enter Start Date (YYYY-MM-DD):";
-    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-    string startDateStr;
-    getline(cin, startDateStr);
+    // Phase 1: sort one block per thread (a power of two, so merge levels pair up evenly).
+    size_t blockCount = 1;
+    while (blockCount < pool.threadCount()) blockCount *= 2;
+    const size_t blockSize = (n + blockCount - 1) / blockCount;
+    T* data = items.data();
+    T* spare = scratch.data();
+    auto sortBlock = [&](size_t block) {
+        size_t start = min(n, block * blockSize);
+        size_t end = min(n, start + blockSize);
+        sequentialMergeSort(data + start, spare + start, end - start, less);
+    };
+    pool.parallelFor(blockCount, sortBlock);
 
-    cout << setw(30) << left << "| Enter End Date (YYYY-MM-DD):";
-    string endDateStr;
-    getline(cin, endDateStr);
-    cout << string(45, '*') << endl;
+    // Phase 2: merge sorted runs pairwise, each merge split into equal output slices.
+    T* source = data;
+    T* target = spare;
+    for (size_t width = blockSize; width < n; width *= 2) {
+        const size_t mergeCount = (n + 2 * width - 1) / (2 * width);
+        const size_t slicesPerMerge = max<size_t>(1, blockCount / mergeCount);
+        auto mergeSlice = [&](size_t task) {
+            size_t start = (task / slicesPerMerge) * 2 * width;
+            size_t mid = min(n, start + width);
+            size_t end = min(n, start + 2 * width);
+            const T* a = source + start;
+            const T* b = source + mid;
+            size_t aSize = mid - start, bSize = end - mid, total = aSize + bSize;
+            size_t slice = task % slicesPerMerge;
+            size_t kBegin = total * slice / slicesPerMerge;
+            size_t kEnd = total * (slice + 1) / slicesPerMerge;
+            size_t iBegin = mergePathSplit(a, aSize, b, bSize, kBegin, less);
+            size_t iEnd = mergePathSplit(a, aSize, b, bSize, kEnd, less);
+            mergeRuns(a + iBegin, iEnd - iBegin, b + (kBegin - iBegin), (kEnd - iEnd) - (kBegin - iBegin),
+                      target + start + kBegin, less);
+        };
+        pool.parallelFor(mergeCount * slicesPerMerge, mergeSlice);
+        swap(source, target);
+    }
+    if (source != data) {
+        auto copyBlock = [&](size_t block) {
+            size_t start = min(n, block * blockSize);
+            size_t end = min(n, start + blockSize);
+            copy(source + start, source + end, data + start);
+        };
+        pool.parallelFor(blockCount, copyBlock);
+    }
+}
 
-    // Convert date strings to their corresponding numerical indices.
-    // Use lower_bound to find the first index >= startDateStr.
-    auto it_start = lower_bound(indexToDateMap.begin(), indexToDateMap.end(), startDateStr);
-    // Use upper_bound to find the first index > endDateStr, then subtract 1 to get the last index <= endDateStr.
-    auto it_end = upper_bound(indexToDateMap.begin(), indexToDateMap.end(), endDateStr);
 
-    int startIdx = distance(indexToDateMap.begin(), it_start);
-    int endIdx = distance(indexToDateMap.begin(), it_end) - 1; // Corrected to be inclusive
+// --- Key-Extraction Sorts ---
+// Comparing handles through events[h] costs a cache miss into a large Event record for
+// every comparison. The name sort below (and the radix date sort in the benchmark)
+// instead extract each event's sort key once into a packed array of (key, handle)
+// entries, sort that array, and read the handles back out.
 
-    // Validate the obtained indices to ensure a valid range for query.
-    if (startIdx >= indexToDateMap.size() || endIdx < 0 || startIdx > endIdx) {
-        cout << "\nNo events found in the date range [" << startDateStr << " to " << endDateStr << "]. 😔" << endl;
-        return;
-    }
+// Sort entry for name ordering: the first 16 bytes of the name packed big-endian into
+// two integers (so integer order equals string order on those bytes) and the handle.
+struct NameSortKey {
+    uint64_t high;
+    uint64_t low;
+    EventHandle handle;
+};
 
-    // Perform the segment tree query on the valid index range.
-    int numDates = indexToDateMap.size(); // Total number of unique dates mapped.
-    int eventCount = querySegmentTree(1, 0, numDates - 1, startIdx, endIdx);
+// Packs 8 bytes of a name starting at 'offset', zero-padded, into a big-endian integer.
+uint64_t namePrefixKey(const string& name, size_t offset) {
+    uint64_t key = 0;
+    for (size_t i = offset; i < offset + 8; i++) {
+        key = (key << 8) | (i < name.size() ? static_cast<unsigned char>(name[i]) : 0);
+    }
+    return key;
+}
 
-    cout << "\nTotal UEvents in range [" << startDateStr << " to " << endDateStr << "]: " << eventCount << " ✨" << endl;
-    cout << endl;
+// Sorts event handles by name. Most comparisons are settled by the packed prefixes;
+// only names sharing their first 16 bytes fall back to comparing the full strings.
+// The key buffers are local, so concurrent sorts never share them.
+void sortEventsByName(vector<EventHandle>& eventList) {
+    const size_t n = eventList.size();
+    vector<NameSortKey> nameKeys(n), nameKeysScratch(n);
+    for (size_t i = 0; i < n; i++) {
+        const string& name = events[eventList[i]].name;
+        nameKeys[i] = {namePrefixKey(name, 0), namePrefixKey(name, 8), eventList[i]};
+    }
+    parallelMergeSort(nameKeys, nameKeysScratch,
+                      [](const NameSortKey& a, const NameSortKey& b) {
+                          if (a.high != b.high) return a.high < b.high;
+                          if (a.low != b.low) return a.low < b.low;
+                          return events[a.handle].name < events[b.handle].name;
+                      },
+                      sharedWorkerPool());
+    for (size_t i = 0; i < n; i++) {
+        eventList[i] = nameKeys[i].handle;
+    }
 }
 
+// --- Existing General Helper Functions ---
 
-// Creative Terminal Interface - UEvent Organizer
-// Displays the main menu for the application.
-void displayMenu() {
-    cout << "\n";
-    cout << "  ╔═════════════════════════════════════════════════╗\n";
-    cout << "  ║                                                 ║\n";
-    cout << "  ║             ██████╗ ███████╗ ██████╗            ║\n";
-    cout << "  ║            ██╔════╝ ██╔════╝██╔═══██╗           ║\n";
-    cout << "  ║            ██║  ███╗███████╗██║   ██║           ║\n";
-    cout << "  ║            ██║  ██╔╝╚════██║██║   ██║           ║\n";
-    cout << "  ║            ╚██████║ ███████║╚██████╔╝           ║\n";
-    cout << "  ║             ╚═════╝ ╚══════╝ ╚═════╝            ║\n";
-    cout << "  ║                                                 ║\n";
-    cout << "  ║              ✨ UEvent Organizer ✨             ║\n";
-    cout << "  ║                                                 ║\n";
-    cout << "  ╚═════════════════════════════════════════════════╝\n";
-    cout << "  [1] ➕ Add New UEvent\n";
-    cout << "  [2] 📜 View All UEvents\n";
-    cout << "  [3] 🔍 Search UEvent by Name\n";
-    cout << "  [4] ✍️ Register for a UEvent\n";
-    cout << "  [5] 🏷️ View UEvents by Department\n";
-    cout << "  [6] 📅 View UEvents Sorted by Date (Merge Sort) \n"; // Updated description
-    cout << "  [7] 🔎 Search UEvents by Date \n";    // Demonstrates Linear Search
-    cout << "  [8] 📊 Count UEvents by Date Range \n"; // Demonstrates Segment Tree for range query
-    cout << "  [9] 🚪 Exit\n"; // Exit option.
-    cout << "  " << string(45, '-') << "\n";
-    cout << "  ➡️ Enter your choice: ";
-}
-
-int main() {
-    // Initial update of secondary data structures and segment tree.
-    // This sets up all necessary data structures before the menu loop begins.
-    updateSecondaryDataStructures();
-
-    int choice;
-    do {
-        clearScreen(); // Clear the screen before displaying the menu each time
-        displayMenu();
-        // Input validation for menu choice.
-        while (!(cin >> choice)) {
-            cout << "Invalid input. Please enter a number: ";
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        }
-
-        switch (choice) {
-            case 1:
-                addEvent();
-                break;
-            case 2:
-                displayAllEvents();
-                break;
-            case 3:
-                searchEvent();
-                break;
-            case 4:
-                registerParticipant();
-                break;
-            case 5:
-                displayEventsByDepartment();
-                break;
-            case 6:
-                displayEventsSortedByDate();
-                break;
-            case 7:
-                searchEventsByDate();
-                break;
-            case 8: // New case for Segment Tree functionality
-                queryEventsByDateRange();
-                break;
-            case 9: // Exit option
-                clearScreen(); // Clear one last time before exiting
-                cout << "\n👋 Exiting UEvent Organizer. Have a great day! 👋\n";
-                break;
-            default:
-                cout << "\n⚠️ Invalid choice. Please try again. ⚠️\n";
-        }
-        if (choice != 9) { // Don't pause if exiting
-            cout << "\nPress Enter to continue...";
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cin.get(); // Wait for user to press Enter
-        }
-    } while (choice != 9); // Loop continues until user chooses to exit.
-
-    return 0;
+// Simple function to center a string within a given width.
+string center(const string& s, int w) {
+    if (s.length() >= w) return s;
+    int padding = (w - s.length()) / 2;
+    return string(padding, ' ') + s + string(w - s.length() - padding, ' ');
+}
+
+// Parses all of 'text' as a decimal integer in [low, high] into 'value'. Returns false
+// (leaving 'value' alone) for anything else, including values out of range; never throws.
+template <typename T>
+bool parseInteger(const string& text, T& value, T low, T high) {
+    T parsed;
+    auto result = from_chars(text.data(), text.data() + text.size(), parsed);
+    if (result.ec != errc() || result.ptr != text.data() + text.size() || parsed < low || parsed > high) {
+        return false;
+    }
+    value = parsed;
+    return true;
+}
+
+// Reports a command-line option value that parseInteger() rejected.
+void reportInvalidOption(const string& name, const string& value) {
+    cerr << "Invalid value '" << value << "' for " << name << "." << endl;
+}
+
+// Function to rebuild all secondary data structures from scratch.
+// Used at startup; single insertions go through insertEvent() instead.
+void updateSecondaryDataStructures() {
+    rebuildEventColumns();
+
+    // Clear and repopulate the name index, name trie and department lookup.
+    eventNameIndex.clear();
+    eventsByDepartment.clear();
+    rebuildDepartmentIndex();
+    clearNameTrie();
+
+    eventNameIndex.reserve(events.size());
+    vector<EventHandle> byName(events.size());
+    for (EventHandle h = 0; h < events.size(); h++) {
+        eventNameIndex.insert(h);
+        byName[h] = h;
+    }
+    sortEventsByName(byName);
+    // Inserting in name order lays the trie out depth-first, keeping each subtree's
+    // nodes and labels close together in memory for the walks.
+    for (EventHandle handle : byName) {
+        addToNameTrie(handle);
+    }
+    // Walk events in name order so every department vector comes out sorted by name.
+    for (EventHandle handle : byName) {
+        eventsByDepartment[events[handle].department].push_back(handle);
+    }
+    // Rebuild the per-day counts of the date index and the per-day buckets,
+    // each bucket ordered by start time (then name).
+    rebuildDateIndex();
+    eventsByDate.clear();
+    for (EventHandle handle : byName) {
+        eventsByDate[events[handle].date].push_back(handle);
+    }
+    for (auto& bucket : eventsByDate) {
+        sort(bucket.second.begin(), bucket.second.end(), startsBefore);
+    }
+
+    // Rebuild the location/day booking schedules used for conflict detection.
+    schedulesByLocationDay.clear();
+    for (EventHandle h = 0; h < events.size(); h++) {
+        addToSchedule(h);
+    }
+}
+
+// Empties the event store and every secondary index.
+void clearEventStore() {
+    events.clear();
+    rosterArena.clear();
+    clearParticipantNames();
+    updateSecondaryDataStructures();
+}
+
+// --- Persistence: Write-Ahead Log and Snapshots ---
+// Every mutation (new event, new registration) is appended to a write-ahead log and
+// synced to disk before the operation reports success; a record that cannot be written
+// is reported on stderr and cut off again, so the log never keeps a partial record.
+// Periodically, and on exit, the whole store is written to a compact binary snapshot and
+// the log is truncated. The periodic snapshot is taken by the main thread between
+// operations (checkpointIfDue), never inside a mutation. At startup the snapshot is
+// memory-mapped and decoded straight into the event store, the log tail is replayed on
+// top of it, and the secondary indexes are built once at the end. Restart cost is
+// therefore one sequential pass over the snapshot, not a replay of every mutation.
+//
+// A snapshot is synced, renamed into place and its directory synced before the log is
+// truncated, so a crash at any point leaves either the old snapshot and the full log or
+// the new snapshot. A damaged snapshot is moved aside at startup (see openEventStore).
+//
+// Both files store integers in host byte order and strings as a 32-bit length
+// followed by the raw bytes.
+//
+// Snapshot layout: magic "UEVSNAP1", u64 last log sequence number (LSN) included,
+//                  u32 event count, the events in handle order, u32 FNV-1a checksum
+//                  of everything after the magic.
+// Log record:      u32 body length, u32 FNV-1a checksum of the body, then the body:
+//                  u8 record type, u64 LSN, type-specific payload.
+const char* const SNAPSHOT_PATH = "uevents.snapshot";
+const char* const WAL_PATH = "uevents.wal";
+const char SNAPSHOT_MAGIC[8] = {'U', 'E', 'V', 'S', 'N', 'A', 'P', '1'};
+// Number of log records after which a fresh snapshot is written automatically.
+const size_t SNAPSHOT_INTERVAL = 10000;
+
+// Log record types.
+const uint8_t WAL_EVENT_ADDED = 1;           // payload: encoded event
+const uint8_t WAL_PARTICIPANT_REGISTERED = 2; // payload: u32 handle, name, course
+
+// Log appends use group commit. An appender copies its record into the open batch under
+// walMutex (a short critical section) and waits. Whichever waiter finds no write in
+// progress becomes the leader: it takes the whole batch, writes and syncs it outside the
+// lock, and wakes everyone the batch covered. Concurrent registrations therefore share
+// one fsync instead of queueing for one each.
+struct WalBatch {
+    string records;
+    bool done = false;   // Written (or failed) and no longer open
+    bool synced = false; // On disk
+};
+
+// Everything below is guarded by walMutex. walFile is only replaced by the main thread,
+// between operations, but other threads read it during appends.
+mutex walMutex;
+condition_variable walBatchDone;
+// Open log file, or null while persistence is disabled (e.g. before startup).
+FILE* walFile = nullptr;
+// LSN of the most recent mutation.
+uint64_t lastLsn = 0;
+// Size of the log in bytes; a failed write is cut back to it.
+uint64_t walBytes = 0;
+// Log records appended since the last snapshot.
+size_t walRecordsSinceSnapshot = 0;
+// Batch that new records join, and whether a leader is writing the previous one.
+shared_ptr<WalBatch> walOpenBatch = make_shared<WalBatch>();
+bool walWriting = false;
+// Set when the log no longer covers the store: a batch could not be written, or
+// changes were made without logging and the snapshot meant to save them failed. Log
+// records refer to events by position, so appending after such a gap would make replay
+// attach later records to the wrong events. Appends therefore stop until a snapshot
+// saves the whole store and restarts the log (see checkpointIfDue).
+bool walSuspended = false;
+
+// 32-bit FNV-1a hash, used as a checksum for snapshots and log records.
+uint32_t fnv1a(const char* data, size_t size, uint32_t hash = 2166136261u) {
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+// Flushes a file and asks the operating system to write it to disk.
+// Returns false if either step fails.
+bool syncFile(FILE* file) {
+    if (fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Opens a log file unbuffered: each batch is one fwrite anyway, and a failed write must
+// not leave bytes in a stdio buffer to be written after the log has been cut back.
+FILE* openLogFile(const char* path, const char* mode) {
+    FILE* file = fopen(path, mode);
+    if (file != nullptr) {
+        setvbuf(file, nullptr, _IONBF, 0);
+    }
+    return file;
+}
+
+// Cuts an open file back to 'size' bytes and moves to its end, e.g. to drop a partly
+// written log batch.
+void truncateFile(FILE* file, uint64_t size) {
+    fflush(file);
+#ifdef _WIN32
+    _chsize_s(_fileno(file), size);
+#else
+    if (ftruncate(fileno(file), size) != 0) {
+        return; // Left as is; replay stops at the torn record
+    }
+#endif
+    fseek(file, 0, SEEK_END);
+}
+
+// Syncs the current directory, making a rename inside it durable. (Windows has no
+// equivalent; there the rename itself is relied on.)
+void syncCurrentDirectory() {
+#ifndef _WIN32
+    int fd = ::open(".", O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        ::close(fd);
+    }
+#endif
+}
+
+// Appends the raw bytes of a fixed-size value to a byte buffer.
+template <typename T>
+void putValue(string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Appends a length-prefixed string to a byte buffer.
+void putString(string& out, string_view text) {
+    putValue<uint32_t>(out, text.size());
+    out.append(text);
+}
+
+// Sequential decoder over a byte range. Any read past the end clears 'ok'
+// and yields zero/empty values, so callers only need to check 'ok' once.
+struct ByteReader {
+    const char* pos;
+    const char* end;
+    bool ok = true;
+
+    ByteReader(const char* data, size_t size) : pos(data), end(data + size) {}
+
+    template <typename T>
+    T value() {
+        T result{};
+        if (ok && static_cast<size_t>(end - pos) >= sizeof(T)) {
+            memcpy(&result, pos, sizeof(T));
+            pos += sizeof(T);
+        } else {
+            ok = false;
+        }
+        return result;
+    }
+
+    // Returns the next length-prefixed string as a view into the buffer.
+    string_view view() {
+        uint32_t size = value<uint32_t>();
+        if (!ok || static_cast<size_t>(end - pos) < size) {
+            ok = false;
+            return string_view();
+        }
+        string_view result(pos, size);
+        pos += size;
+        return result;
+    }
+
+    string text() { return string(view()); }
+};
+
+// Appends an event and its roster to a byte buffer.
+void encodeEvent(string& out, const Event& event) {
+    putString(out, event.name);
+    putValue<DayNumber>(out, event.date);
+    putValue<MinuteOfDay>(out, event.startTime);
+    putValue<MinuteOfDay>(out, event.endTime);
+    putString(out, locationPool.text(event.location));
+    putString(out, departmentPool.text(event.department));
+    putValue<int32_t>(out, event.capacity);
+    int registered = event.participants;
+    putValue<uint32_t>(out, registered);
+    for (int i = 0; i < registered; i++) {
+        putString(out, rosterName(event.roster[i]));
+        putString(out, coursePool.text(event.roster[i].course));
+    }
+}
+
+// Participants of a decoded event; the names point into the buffer being decoded.
+typedef vector<pair<string_view, SymbolId>> DecodedRoster;
+
+// Decodes an event written by encodeEvent(), interning its text fields. The roster is
+// returned separately, as it can only be stored once the event has its slots.
+// Returns false on truncated or invalid input.
+bool decodeEvent(ByteReader& in, Event& event, DecodedRoster& roster) {
+    event.name = in.text();
+    event.date = in.value<DayNumber>();
+    event.startTime = in.value<MinuteOfDay>();
+    event.endTime = in.value<MinuteOfDay>();
+    event.location = locationPool.intern(in.view());
+    event.department = departmentPool.intern(in.view());
+    event.capacity = in.value<int32_t>();
+    uint32_t rosterSize = in.value<uint32_t>();
+    if (event.capacity <= 0 || event.capacity > MAX_EVENT_CAPACITY || rosterSize > static_cast<uint32_t>(event.capacity)) {
+        return false;
+    }
+    roster.clear();
+    for (uint32_t i = 0; i < rosterSize && in.ok; i++) {
+        string_view name = in.view();
+        roster.push_back({name, coursePool.intern(in.view())});
+    }
+    return in.ok;
+}
+
+// Stores a decoded event and its roster.
+void addDecodedEvent(const Event& event, const DecodedRoster& roster) {
+    Event& stored = events[events.add(event)];
+    for (const auto& participant : roster) {
+        appendRosterEntry(stored, participant.first, participant.second);
+    }
+}
+
+// Read-only view of a whole file: memory-mapped where available, read into memory otherwise.
+struct MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    string contents;
+#endif
+
+    // Returns false if the file does not exist or cannot be read.
+    bool open(const char* path) {
+#ifdef _WIN32
+        ifstream in(path, ios::binary);
+        if (!in) return false;
+        contents.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        data = contents.data();
+        size = contents.size();
+        return true;
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        size = info.st_size;
+        if (size > 0) {
+            void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        ::close(fd); // The mapping stays valid after the descriptor is closed.
+        return true;
+#endif
+    }
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (data != nullptr) munmap(const_cast<char*>(data), size);
+#endif
+    }
+};
+
+// Writes the whole event store to a new snapshot and truncates the log.
+// The snapshot is written to a temporary file and renamed into place, so a crash
+// mid-write leaves the previous snapshot intact. Log records it already covers are
+// recognised by their LSN if the truncation does not happen.
+bool writeSnapshot() {
+    string tempPath = string(SNAPSHOT_PATH) + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if (file == nullptr) {
+        cerr << "⚠️ Could not write snapshot '" << tempPath << "'. ⚠️" << endl;
+        return false;
+    }
+
+    string buffer;
+    {
+        lock_guard<mutex> guard(walMutex);
+        putValue<uint64_t>(buffer, lastLsn);
+    }
+    putValue<uint32_t>(buffer, events.size());
+    uint32_t checksum = 2166136261u;
+    bool written = fwrite(SNAPSHOT_MAGIC, 1, sizeof(SNAPSHOT_MAGIC), file) == sizeof(SNAPSHOT_MAGIC);
+    for (EventHandle h = 0; h <= events.size() && written; h++) {
+        if (h < events.size()) {
+            encodeEvent(buffer, events[h]);
+        }
+        // Flush in large blocks to keep memory bounded for big stores.
+        if (buffer.size() >= (1 << 20) || h == events.size()) {
+            checksum = fnv1a(buffer.data(), buffer.size(), checksum);
+            written = fwrite(buffer.data(), 1, buffer.size(), file) == buffer.size();
+            buffer.clear();
+        }
+    }
+    written = written && fwrite(&checksum, 1, sizeof(checksum), file) == sizeof(checksum);
+    written = written && syncFile(file);
+    written = (fclose(file) == 0) && written;
+    if (!written || rename(tempPath.c_str(), SNAPSHOT_PATH) != 0) {
+        cerr << "⚠️ Could not write snapshot '" << SNAPSHOT_PATH << "'. ⚠️" << endl;
+        remove(tempPath.c_str());
+        return false;
+    }
+    syncCurrentDirectory(); // The rename must be on disk before the log is cut
+
+    // Everything up to lastLsn is now in the snapshot; start a fresh log (once any
+    // batch still being written is done with the old one).
+    unique_lock<mutex> lock(walMutex);
+    walBatchDone.wait(lock, [] { return !walWriting; });
+    if (walFile != nullptr) {
+        fclose(walFile);
+        walFile = openLogFile(WAL_PATH, "wb");
+        walBytes = 0;
+        if (walFile == nullptr) {
+            cerr << "⚠️ Could not reopen log '" << WAL_PATH << "'. Changes will not be saved. ⚠️" << endl;
+        }
+    }
+    walRecordsSinceSnapshot = 0;
+    walSuspended = false;
+    return true;
+}
+
+// Stops log appends until the next successful snapshot (see walSuspended).
+void suspendWal() {
+    lock_guard<mutex> guard(walMutex);
+    walSuspended = true;
+}
+
+// Appends one record to the log and returns once it is synced to disk, as part of a
+// group commit (see WalBatch). Does nothing (and succeeds) while persistence is
+// disabled. If the batch cannot be written (e.g. the disk is full) the log is cut back
+// to its last complete record, a warning goes to stderr, false is returned and the log
+// is suspended: this and every later change live only in memory until the snapshot
+// that checkpointIfDue() then takes at once.
+bool appendWalRecord(uint8_t type, const string& payload) {
+    string body;
+    putValue<uint8_t>(body, type);
+    putValue<uint64_t>(body, 0); // LSN, filled in under the lock
+    body.append(payload);
+
+    unique_lock<mutex> lock(walMutex);
+    if (walFile == nullptr) {
+        return true;
+    }
+    if (walSuspended) {
+        return false;
+    }
+    uint64_t lsn = ++lastLsn;
+    memcpy(&body[sizeof(uint8_t)], &lsn, sizeof(lsn));
+    shared_ptr<WalBatch> batch = walOpenBatch;
+    putValue<uint32_t>(batch->records, body.size());
+    putValue<uint32_t>(batch->records, fnv1a(body.data(), body.size()));
+    batch->records.append(body);
+    walRecordsSinceSnapshot++;
+
+    while (!batch->done) {
+        if (walWriting) {
+            walBatchDone.wait(lock);
+            continue;
+        }
+        // Lead: nothing is being written, so 'batch' is still the open one.
+        walOpenBatch = make_shared<WalBatch>();
+        if (walSuspended) {
+            // An earlier batch failed after this one was opened: writing it would leave a gap.
+            batch->done = true;
+            walBatchDone.notify_all();
+            break;
+        }
+        walWriting = true;
+        FILE* file = walFile;
+        uint64_t startBytes = walBytes;
+        lock.unlock();
+        bool synced = fwrite(batch->records.data(), 1, batch->records.size(), file) == batch->records.size() &&
+                      syncFile(file);
+        if (!synced) {
+            cerr << "⚠️ Could not write to log '" << WAL_PATH << "' (" << strerror(errno)
+                 << "). Changes are not saved until a snapshot succeeds. ⚠️" << endl;
+            clearerr(file);
+            truncateFile(file, startBytes);
+        }
+        lock.lock();
+        if (synced) walBytes += batch->records.size();
+        walSuspended = walSuspended || !synced;
+        batch->synced = synced;
+        batch->done = true;
+        walWriting = false;
+        walBatchDone.notify_all();
+    }
+    return batch->synced;
+}
+
+// Writes a snapshot if enough log records have accumulated since the last one, or at
+// once while the log is suspended, since only a snapshot can save the changes made
+// since then. Called by the main thread between operations, when no registration is in
+// flight.
+void checkpointIfDue() {
+    bool due;
+    {
+        lock_guard<mutex> guard(walMutex);
+        due = walFile != nullptr && (walSuspended || walRecordsSinceSnapshot >= SNAPSHOT_INTERVAL);
+    }
+    if (due) {
+        writeSnapshot();
+    }
+}
+
+// Logs the creation of the event stored at 'handle'. Returns false if it was not saved.
+bool logEventAdded(EventHandle handle) {
+    string payload;
+    encodeEvent(payload, events[handle]);
+    return appendWalRecord(WAL_EVENT_ADDED, payload);
+}
+
+// Logs the registration of a participant for the event stored at 'handle'.
+// Returns false if it was not saved.
+bool logParticipantRegistered(EventHandle handle, const Participant& participant) {
+    string payload;
+    putValue<uint32_t>(payload, handle);
+    putString(payload, participant.name);
+    putString(payload, coursePool.text(participant.course));
+    return appendWalRecord(WAL_PARTICIPANT_REGISTERED, payload);
+}
+
+// Decodes the snapshot (if any) directly into the event store.
+// Sets snapshotLsn to the last LSN the snapshot covers. Returns false if the
+// snapshot exists but is damaged.
+bool loadSnapshot(uint64_t& snapshotLsn) {
+    snapshotLsn = 0;
+    MappedFile file;
+    if (!file.open(SNAPSHOT_PATH)) {
+        return true; // No snapshot yet: start from an empty store.
+    }
+    const size_t headerSize = sizeof(SNAPSHOT_MAGIC);
+    const size_t trailerSize = sizeof(uint32_t);
+    if (file.size < headerSize + trailerSize || memcmp(file.data, SNAPSHOT_MAGIC, headerSize) != 0) {
+        return false;
+    }
+    const char* body = file.data + headerSize;
+    size_t bodySize = file.size - headerSize - trailerSize;
+    uint32_t storedChecksum;
+    memcpy(&storedChecksum, body + bodySize, trailerSize);
+    if (fnv1a(body, bodySize) != storedChecksum) {
+        return false;
+    }
+
+    ByteReader in(body, bodySize);
+    snapshotLsn = in.value<uint64_t>();
+    uint32_t eventCount = in.value<uint32_t>();
+    Event event;
+    DecodedRoster roster;
+    for (uint32_t i = 0; i < eventCount; i++) {
+        if (!decodeEvent(in, event, roster)) {
+            return false;
+        }
+        addDecodedEvent(event, roster);
+    }
+    return in.ok;
+}
+
+// Replays log records newer than the snapshot into the event store.
+// Replay stops at the first incomplete or corrupt record (e.g. a write torn by a
+// crash), and the log is cut back to the last good record so appends continue cleanly.
+// If it cannot be cut back, the log is suspended until a snapshot replaces it.
+void replayWal(uint64_t snapshotLsn) {
+    size_t validSize = 0;
+    {
+        MappedFile file;
+        if (!file.open(WAL_PATH)) {
+            return;
+        }
+        ByteReader in(file.data, file.size);
+        while (in.pos < in.end) {
+            uint32_t bodySize = in.value<uint32_t>();
+            uint32_t checksum = in.value<uint32_t>();
+            if (!in.ok || static_cast<size_t>(in.end - in.pos) < bodySize ||
+                fnv1a(in.pos, bodySize) != checksum) {
+                break;
+            }
+            ByteReader record(in.pos, bodySize);
+            in.pos += bodySize;
+            uint8_t type = record.value<uint8_t>();
+            uint64_t lsn = record.value<uint64_t>();
+            if (lsn > snapshotLsn) {
+                if (type == WAL_EVENT_ADDED) {
+                    Event event;
+                    DecodedRoster roster;
+                    if (!decodeEvent(record, event, roster)) break;
+                    addDecodedEvent(event, roster);
+                } else if (type == WAL_PARTICIPANT_REGISTERED) {
+                    EventHandle handle = record.value<uint32_t>();
+                    string_view name = record.view();
+                    string_view course = record.view();
+                    if (!record.ok || handle >= events.size() ||
+                        events[handle].participants >= events[handle].capacity) {
+                        break;
+                    }
+                    appendRosterEntry(events[handle], name, coursePool.intern(course));
+                } else {
+                    break;
+                }
+            }
+            lastLsn = max(lastLsn, lsn);
+            validSize = in.pos - file.data;
+            walRecordsSinceSnapshot++;
+        }
+        if (validSize == file.size) {
+            return;
+        }
+    }
+    cerr << "⚠️ Discarding a damaged tail of the log '" << WAL_PATH << "'. ⚠️" << endl;
+    error_code error;
+    filesystem::resize_file(WAL_PATH, validSize, error);
+    if (error) {
+        // Appending after the damaged tail would hide the new records from replay.
+        cerr << "⚠️ Could not cut back log '" << WAL_PATH << "' (" << error.message()
+             << "). Changes are not saved until a snapshot succeeds. ⚠️" << endl;
+        walSuspended = true;
+    }
+}
+
+// Returns true if the log holds the whole history of the store, i.e. its first record
+// has LSN 1 because no snapshot has truncated it yet, or if it is empty or missing.
+bool walCoversWholeHistory() {
+    MappedFile file;
+    if (!file.open(WAL_PATH) || file.size == 0) {
+        return true;
+    }
+    ByteReader in(file.data, file.size);
+    in.value<uint32_t>(); // Body length
+    in.value<uint32_t>(); // Checksum
+    in.value<uint8_t>();  // Record type
+    return in.ok && in.value<uint64_t>() == 1;
+}
+
+// Moves a damaged file to '<path>.damaged' so it is kept for inspection but never
+// loaded or overwritten. Returns false if it could not be moved.
+bool moveAside(const char* path) {
+    string aside = string(path) + ".damaged";
+    remove(aside.c_str());
+    if (rename(path, aside.c_str()) != 0) {
+        return false;
+    }
+    cerr << "   Moved '" << path << "' to '" << aside << "'." << endl;
+    return true;
+}
+
+// Restores the event store from disk and enables logging of new mutations.
+//
+// If the snapshot is damaged it is moved aside. A log that still holds the whole
+// history is then replayed on its own; a log that only continues the damaged snapshot
+// is useless without it (its records refer to events by position), so it is moved
+// aside too and the store starts empty. Returns false only if a damaged file cannot be
+// moved, in which case nothing should be written.
+bool openEventStore() {
+    uint64_t snapshotLsn;
+    if (!loadSnapshot(snapshotLsn)) {
+        cerr << "⚠️ Snapshot '" << SNAPSHOT_PATH << "' is damaged. ⚠️" << endl;
+        clearEventStore();
+        snapshotLsn = 0;
+        if (!moveAside(SNAPSHOT_PATH)) {
+            return false;
+        }
+        if (walCoversWholeHistory()) {
+            cerr << "   Rebuilding the UEvents from the log alone." << endl;
+        } else {
+            cerr << "   The log only holds changes made after that snapshot; starting with no UEvents." << endl;
+            if (!moveAside(WAL_PATH)) {
+                return false;
+            }
+        }
+    }
+    lastLsn = snapshotLsn;
+    replayWal(snapshotLsn);
+
+    // One index build for the whole restored store.
+    updateSecondaryDataStructures();
+
+    walFile = openLogFile(WAL_PATH, "ab");
+    if (walFile == nullptr) {
+        cerr << "⚠️ Could not open log '" << WAL_PATH << "'. Changes will not be saved. ⚠️" << endl;
+    } else {
+        fseek(walFile, 0, SEEK_END);
+        walBytes = ftell(walFile);
+    }
+    return true;
+}
+
+// Writes a final snapshot (so the next start needs no log replay) and closes the log.
+// Returns false if the snapshot failed.
+bool closeEventStore() {
+    if (walFile == nullptr) {
+        return true;
+    }
+    bool saved = writeSnapshot();
+    lock_guard<mutex> guard(walMutex);
+    if (walFile != nullptr) {
+        fclose(walFile);
+        walFile = nullptr;
+    }
+    return saved;
+}
+
+// Function to insert a new event incrementally.
+// The event is added to the store (O(1), no existing event moves) and receives its ID.
+// Each index is then patched in place with the new handle: the name index in expected
+// O(1), the name trie along the name's path, the department vector, the day's date
+// bucket and the location/day booking schedule at their sorted positions, and the date
+// index with an O(log D) Fenwick point update (also for dates that no event has used
+// before).
+// The insertion is recorded in the write-ahead log.
+// Assumes the caller has already checked that the name is not taken.
+EventHandle insertEvent(const Event& newEvent) {
+    EventHandle handle = events.add(newEvent);
+    const Event& event = events[handle];
+    eventColumns.append(event);
+
+    eventNameIndex.insert(handle);
+    addToNameTrie(handle);
+
+    auto byName = [](EventHandle a, EventHandle b) { return events[a].name < events[b].name; };
+    indexNewDepartments();
+    vector<EventHandle>& departmentEvents = eventsByDepartment[event.department];
+    departmentEvents.insert(upper_bound(departmentEvents.begin(), departmentEvents.end(), handle, byName), handle);
+
+    fenwickAdd(event.date, 1);
+    vector<EventHandle>& dayEvents = eventsByDate[event.date];
+    dayEvents.insert(upper_bound(dayEvents.begin(), dayEvents.end(), handle, startsBefore), handle);
+
+    addToSchedule(handle);
+
+    logEventAdded(handle);
+    return handle;
+}
+
+// Registers a participant for the event stored at 'handle' and records it in the log.
+// Returns false (and changes nothing) if the event is already full.
+//
+// Registrations may run concurrently with each other and with readers of the rosters,
+// but not with anything that adds events or rebuilds indexes; those run on the main
+// thread in between. The seat is reserved lock-free and committed once its entry is
+// written, and the log record then joins a group commit (see appendWalRecord), so
+// concurrent registrations never wait for each other's fsync.
+bool addParticipant(EventHandle handle, const Participant& participant) {
+    if (!appendRosterEntry(events[handle], participant.name, participant.course)) {
+        return false;
+    }
+    atomicAddRelaxed(eventColumns.participants[handle], 1);
+    logParticipantRegistered(handle, participant);
+    return true;
+}
+
+// --- Bulk Import (CSV / JSON Lines) ---
+// Loads events and registrations from a file in one pass instead of one prompt at a time.
+// Records are read one per line, in either of two text formats (chosen by the ".jsonl"/".json"
+// extension, CSV otherwise):
+//
+//   CSV:        event,<name>,<YYYY-MM-DD>,<HH:MM start>,<HH:MM end>,<location>,<department>,<capacity>
+//               register,<event name>,<participant name>,<course>
+//               Fields may be double-quoted ("" inside quotes is a literal quote), and a
+//               quoted field may contain line breaks, so one record can span several lines.
+//               Empty lines, lines starting with '#' and a header line starting with "type" are skipped.
+//   JSON lines: {"type":"event","name":...,"date":...,"start":...,"end":...,"location":...,
+//                "department":...,"capacity":...}
+//               {"type":"register","event":...,"name":...,"course":...}
+//
+// A ".bin" file is read as a binary export (see "Export") instead; its rosters are
+// applied like register records.
+//
+// Imported events get the same checks as events added from the menu: an event whose
+// name is taken, or whose location is already booked for part of its time slot (by a
+// stored event or an earlier record in the file), is skipped and counted in the summary.
+//
+// The file is mapped into memory and split into one chunk per hardware thread at line
+// boundaries. Chunks are parsed in parallel into plain records; the records are then
+// added to the store in file order on the calling thread, and all secondary indexes are
+// built once at the end. Instead of logging every record, a snapshot is written afterwards.
+//
+// A cut can land inside a quoted CSV field. The chunk before it then reads its last record
+// past the cut, and the chunk after it, which started mid-record, is parsed again from
+// where that record really ended.
+
+// Magic bytes at the start of a binary export.
+const char EXPORT_MAGIC[8] = {'U', 'E', 'V', 'E', 'X', 'P', 'T', '1'};
+
+// A registration read from an import file, resolved to an event by name after parsing.
+struct ImportedRegistration {
+    string eventName;
+    Participant participant;
+};
+
+// Records parsed from one chunk of an import file. Each parsing thread interns text fields
+// into its chunk's own pools, so no pool is shared between threads; the chunk's ids are
+// mapped onto the global pools when its records are added.
+struct ImportChunk {
+    vector<Event> events;
+    vector<ImportedRegistration> registrations;
+    SymbolPool locations;
+    SymbolPool departments;
+    SymbolPool courses;
+    size_t malformedLines = 0;
+    const char* parsedEnd = nullptr; // Start of the first record after this chunk
+};
+
+// Totals reported after an import.
+struct ImportSummary {
+    size_t eventsAdded = 0;
+    size_t registrationsAdded = 0;
+    size_t malformedLines = 0;
+    size_t duplicateEvents = 0;
+    size_t conflictingEvents = 0;     // Location already booked during that time
+    size_t rejectedRegistrations = 0; // Unknown event or event already full
+    bool saved = true;                // False if the snapshot that persists the import failed
+};
+
+// Splits one CSV line into fields. Returns false on an unterminated quote.
+bool splitCsvLine(const char* pos, const char* end, vector<string>& fields) {
+    fields.clear();
+    string field;
+    bool quoted = false;
+    for (; pos < end; pos++) {
+        char c = *pos;
+        if (quoted) {
+            if (c == '"') {
+                if (pos + 1 < end && pos[1] == '"') {
+                    field += '"';
+                    pos++;
+                } else {
+                    quoted = false;
+                }
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.push_back(field);
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    fields.push_back(field);
+    return !quoted;
+}
+
+// Appends the UTF-8 encoding of a code point.
+void appendUtf8(string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+// Parses a flat JSON object whose values are strings, numbers, booleans or null into
+// (key, value text) pairs. Nested objects and arrays are not supported.
+// Returns false on any syntax error, including a \u escape that is not four hex digits
+// or a surrogate that is not part of a pair; it never throws.
+bool parseJsonObject(const char* pos, const char* end, vector<pair<string, string>>& fields) {
+    fields.clear();
+    auto skipSpace = [&]() { while (pos < end && isspace(static_cast<unsigned char>(*pos))) pos++; };
+    // Reads the four hex digits after the 'u' at 'pos', leaving 'pos' on the last digit.
+    auto parseHexEscape = [&](uint32_t& value) {
+        if (end - pos < 5) return false;
+        for (int i = 1; i <= 4; i++) {
+            if (!isxdigit(static_cast<unsigned char>(pos[i]))) return false;
+        }
+        from_chars(pos + 1, pos + 5, value, 16);
+        pos += 4;
+        return true;
+    };
+    auto parseString = [&](string& out) {
+        out.clear();
+        if (pos >= end || *pos != '"') return false;
+        for (pos++; pos < end && *pos != '"'; pos++) {
+            if (*pos != '\\') {
+                out += *pos;
+                continue;
+            }
+            if (++pos >= end) return false;
+            switch (*pos) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': {
+                    uint32_t codePoint = 0;
+                    if (!parseHexEscape(codePoint)) return false;
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+                        // A high surrogate must be followed by an escaped low surrogate.
+                        uint32_t low = 0;
+                        if (end - pos < 3 || pos[1] != '\\' || pos[2] != 'u') return false;
+                        pos += 2;
+                        if (!parseHexEscape(low) || low < 0xDC00 || low > 0xDFFF) return false;
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+                        return false; // Low surrogate without a high one
+                    }
+                    appendUtf8(out, codePoint);
+                    break;
+                }
+                default: out += *pos; break; // \" \\ \/
+            }
+        }
+        if (pos >= end) return false;
+        pos++; // Closing quote
+        return true;
+    };
+
+    skipSpace();
+    if (pos >= end || *pos++ != '{') return false;
+    skipSpace();
+    if (pos < end && *pos == '}') return true;
+    while (pos < end) {
+        string key, value;
+        skipSpace();
+        if (!parseString(key)) return false;
+        skipSpace();
+        if (pos >= end || *pos++ != ':') return false;
+        skipSpace();
+        if (pos < end && *pos == '"') {
+            if (!parseString(value)) return false;
+        } else {
+            const char* start = pos;
+            while (pos < end && *pos != ',' && *pos != '}' && !isspace(static_cast<unsigned char>(*pos))) pos++;
+            value.assign(start, pos);
+            if (value.empty()) return false;
+        }
+        fields.push_back({key, value});
+        skipSpace();
+        if (pos < end && *pos == ',') {
+            pos++;
+        } else if (pos < end && *pos == '}') {
+            return true;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+// Builds an event from the text fields of an import record, applying the same
+// validation as addEvent(). Location and department are interned into the given pools.
+// Returns false if any field is invalid.
+bool makeImportedEvent(const string& name, const string& date, const string& start, const string& end,
+                       const string& location, const string& department, const string& capacity,
+                       SymbolPool& locations, SymbolPool& departments, Event& event) {
+    if (name.empty() || !parseDate(date, event.date) || !parseTime(start, event.startTime) ||
+        !parseTime(end, event.endTime) || event.endTime <= event.startTime) {
+        return false;
+    }
+    char* parsedEnd = nullptr;
+    long seats = strtol(capacity.c_str(), &parsedEnd, 10);
+    if (capacity.empty() || *parsedEnd != '\0' || seats <= 0 || seats > MAX_EVENT_CAPACITY) {
+        return false;
+    }
+    event.name = name;
+    event.location = locations.intern(location);
+    event.department = departments.intern(department);
+    event.capacity = seats;
+    event.participants = 0;
+    return true;
+}
+
+// Parses one CSV record into the chunk. Returns false if the line is malformed.
+bool parseCsvRecord(const char* pos, const char* end, vector<string>& fields, ImportChunk& chunk) {
+    if (!splitCsvLine(pos, end, fields)) {
+        return false;
+    }
+    if (fields[0] == "event" && fields.size() == 8) {
+        Event event;
+        if (!makeImportedEvent(fields[1], fields[2], fields[3], fields[4], fields[5], fields[6], fields[7],
+                               chunk.locations, chunk.departments, event)) {
+            return false;
+        }
+        chunk.events.push_back(move(event));
+        return true;
+    }
+    if (fields[0] == "register" && fields.size() == 4 && !fields[1].empty()) {
+        chunk.registrations.push_back({fields[1], {fields[2], chunk.courses.intern(fields[3])}});
+        return true;
+    }
+    return false;
+}
+
+// Parses one JSON-lines record into the chunk. Returns false if the line is malformed.
+bool parseJsonRecord(const char* pos, const char* end, vector<pair<string, string>>& fields, ImportChunk& chunk) {
+    if (!parseJsonObject(pos, end, fields)) {
+        return false;
+    }
+    auto field = [&](const char* key) {
+        for (const auto& entry : fields) {
+            if (entry.first == key) return entry.second;
+        }
+        return string();
+    };
+    string type = field("type");
+    if (type == "event") {
+        Event event;
+        if (!makeImportedEvent(field("name"), field("date"), field("start"), field("end"), field("location"),
+                               field("department"), field("capacity"), chunk.locations, chunk.departments, event)) {
+            return false;
+        }
+        chunk.events.push_back(move(event));
+        return true;
+    }
+    if (type == "register" && !field("event").empty()) {
+        chunk.registrations.push_back({field("event"), {field("name"), chunk.courses.intern(field("course"))}});
+        return true;
+    }
+    return false;
+}
+
+// Returns the end of the CSV record that starts at 'pos': the first line break outside
+// double quotes, or 'end' if there is none. An unterminated quote runs to 'end'.
+const char* findCsvRecordEnd(const char* pos, const char* end) {
+    bool quoted = false;
+    while (pos < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(pos, '\n', end - pos));
+        if (lineEnd == nullptr) {
+            return end;
+        }
+        // Each quote toggles the state; a doubled quote toggles it twice.
+        for (const char* quote = pos; (quote = static_cast<const char*>(memchr(quote, '"', lineEnd - quote))); quote++) {
+            quoted = !quoted;
+        }
+        if (!quoted) {
+            return lineEnd;
+        }
+        pos = lineEnd + 1;
+    }
+    return end;
+}
+
+// Parses every record that starts in [pos, end) into 'chunk'. The last one may run on
+// up to 'fileEnd'. Runs on a worker thread.
+void parseImportChunk(const char* pos, const char* end, const char* fileEnd, bool json, ImportChunk& chunk) {
+    vector<string> csvFields;
+    vector<pair<string, string>> jsonFields;
+    while (pos < end) {
+        const char* lineEnd;
+        if (json || *pos == '#') {
+            lineEnd = static_cast<const char*>(memchr(pos, '\n', fileEnd - pos));
+            if (lineEnd == nullptr) lineEnd = fileEnd;
+        } else {
+            lineEnd = findCsvRecordEnd(pos, fileEnd);
+        }
+        const char* trimmedEnd = lineEnd;
+        if (trimmedEnd > pos && trimmedEnd[-1] == '\r') trimmedEnd--;
+
+        bool skip = trimmedEnd == pos || *pos == '#' || (!json && trimmedEnd - pos >= 4 && memcmp(pos, "type", 4) == 0);
+        if (!skip) {
+            bool parsed = json ? parseJsonRecord(pos, trimmedEnd, jsonFields, chunk)
+                               : parseCsvRecord(pos, trimmedEnd, csvFields, chunk);
+            if (!parsed) chunk.malformedLines++;
+        }
+        pos = lineEnd == fileEnd ? fileEnd : lineEnd + 1;
+    }
+    chunk.parsedEnd = pos;
+}
+
+// Bookings made by the running import, by location and day. schedulesByLocationDay
+// still holds only the events stored before the import, as the index rebuild at the end
+// replaces it anyway. Each imported booking links to the previous one at its location
+// and day; accepted bookings never overlap, so a chain holds at most one booking per
+// minute of the day, and in practice one or two.
+struct ImportBookings {
+    EventHandle firstHandle = events.size();
+    unordered_map<uint64_t, EventHandle> latest; // Location and day -> last booking there
+    vector<EventHandle> previous;                // Handle - firstHandle -> earlier booking there
+    vector<EventHandle> found;                   // Scratch for the stored-schedule check
+
+    explicit ImportBookings(size_t expected) {
+        latest.reserve(expected);
+        previous.reserve(expected);
+    }
+
+    static uint64_t key(const Event& event) {
+        return (static_cast<uint64_t>(event.location) << 32) | static_cast<uint32_t>(event.date);
+    }
+
+    // Returns true if the event's location is booked for part of its time slot.
+    bool overlaps(const Event& event) {
+        found.clear();
+        auto stored = schedulesByLocationDay.find({event.location, event.date});
+        if (stored != schedulesByLocationDay.end()) {
+            findBookingConflicts(stored->second, event.startTime, event.endTime, found);
+            if (!found.empty()) return true;
+        }
+        auto imported = latest.find(key(event));
+        for (EventHandle h = imported == latest.end() ? NO_EVENT : imported->second; h != NO_EVENT;
+             h = previous[h - firstHandle]) {
+            if (events[h].startTime < event.endTime && events[h].endTime > event.startTime) return true;
+        }
+        return false;
+    }
+
+    // Records a booking just stored by the import.
+    void add(EventHandle handle) {
+        auto inserted = latest.insert({key(events[handle]), handle});
+        previous.resize(handle - firstHandle + 1, NO_EVENT);
+        if (!inserted.second) {
+            previous[handle - firstHandle] = inserted.first->second;
+            inserted.first->second = handle;
+        }
+    }
+};
+
+// Stores an imported event unless its name is taken or its location is already booked
+// for part of its time slot, by a stored event or by an earlier record of the same
+// import. Keeps the name index current; everything else is rebuilt once the import is
+// done. Returns NO_EVENT if the event was skipped.
+EventHandle addImportedEvent(const Event& event, ImportBookings& bookings, ImportSummary& summary) {
+    if (eventNameIndex.contains(event.name)) {
+        summary.duplicateEvents++;
+        return NO_EVENT;
+    }
+    if (bookings.overlaps(event)) {
+        summary.conflictingEvents++;
+        return NO_EVENT;
+    }
+    EventHandle handle = events.add(event);
+    eventNameIndex.insert(handle);
+    bookings.add(handle);
+    summary.eventsAdded++;
+    return handle;
+}
+
+// Adds the events and rosters of a binary export with addImportedEvent(). The roster of
+// an event whose name is taken is applied to the stored event of that name; the roster
+// of an event skipped for a booking conflict is rejected. Returns false, without
+// changing the store, if the file is not an intact binary export.
+bool importBinaryExport(const MappedFile& file, ImportSummary& summary) {
+    const size_t headerSize = sizeof(EXPORT_MAGIC);
+    const size_t trailerSize = sizeof(uint32_t);
+    if (file.size < headerSize + trailerSize || memcmp(file.data, EXPORT_MAGIC, headerSize) != 0) {
+        return false;
+    }
+    const char* body = file.data + headerSize;
+    size_t bodySize = file.size - headerSize - trailerSize;
+    uint32_t storedChecksum;
+    memcpy(&storedChecksum, body + bodySize, trailerSize);
+    if (fnv1a(body, bodySize) != storedChecksum) {
+        return false;
+    }
+
+    ByteReader in(body, bodySize);
+    uint32_t eventCount = in.value<uint32_t>();
+    eventNameIndex.reserve(events.size() + eventCount);
+    ImportBookings bookings(eventCount);
+    Event event;
+    DecodedRoster roster;
+    for (uint32_t i = 0; i < eventCount; i++) {
+        if (!decodeEvent(in, event, roster)) {
+            summary.malformedLines++; // Checksummed but undecodable: keep what came before
+            break;
+        }
+        EventHandle handle = eventNameIndex.find(event.name);
+        if (handle == NO_EVENT) {
+            handle = addImportedEvent(event, bookings, summary);
+        } else {
+            summary.duplicateEvents++;
+        }
+        if (handle == NO_EVENT) {
+            summary.rejectedRegistrations += roster.size();
+            continue;
+        }
+        Event& stored = events[handle];
+        for (const auto& participant : roster) {
+            if (appendRosterEntry(stored, participant.first, participant.second)) {
+                summary.registrationsAdded++;
+            } else {
+                summary.rejectedRegistrations++;
+            }
+        }
+    }
+    return true;
+}
+
+// Parses a CSV or JSON-lines file in parallel and adds its records to the store.
+void importTextRecords(const MappedFile& file, bool json, ImportSummary& summary) {
+    // Split into one chunk per thread, moving each boundary forward to the next line start.
+    // Small files are parsed on a single thread.
+    size_t threadCount = max<size_t>(1, thread::hardware_concurrency());
+    threadCount = min(threadCount, max<size_t>(1, file.size / (1 << 16)));
+    vector<const char*> bounds = {file.data};
+    for (size_t i = 1; i < threadCount; i++) {
+        const char* cut = max(bounds.back(), file.data + file.size * i / threadCount);
+        const char* newline = static_cast<const char*>(memchr(cut, '\n', file.data + file.size - cut));
+        bounds.push_back(newline == nullptr ? file.data + file.size : newline + 1);
+    }
+    bounds.push_back(file.data + file.size);
+
+    const char* fileEnd = file.data + file.size;
+    vector<ImportChunk> chunks(threadCount);
+    vector<thread> workers;
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(parseImportChunk, bounds[i], bounds[i + 1], fileEnd, json, ref(chunks[i]));
+    }
+    parseImportChunk(bounds[0], bounds[1], fileEnd, json, chunks[0]);
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    // A chunk whose predecessor read past its start began inside a quoted field.
+    for (size_t i = 1; i < threadCount; i++) {
+        if (chunks[i - 1].parsedEnd != bounds[i]) {
+            chunks[i] = ImportChunk();
+            parseImportChunk(chunks[i - 1].parsedEnd, bounds[i + 1], fileEnd, json, chunks[i]);
+        }
+    }
+
+    // Add events in file order, skipping taken names and booking conflicts.
+    size_t parsedEventCount = 0;
+    for (const ImportChunk& chunk : chunks) {
+        parsedEventCount += chunk.events.size();
+    }
+    eventNameIndex.reserve(events.size() + parsedEventCount);
+    // Translates a chunk-local symbol table into ids of a global pool.
+    auto globalIds = [](const SymbolPool& local, SymbolPool& global) {
+        vector<SymbolId> ids(local.size());
+        for (SymbolId id = 0; id < local.size(); id++) {
+            ids[id] = global.intern(local.text(id));
+        }
+        return ids;
+    };
+    ImportBookings bookings(parsedEventCount);
+    for (ImportChunk& chunk : chunks) {
+        summary.malformedLines += chunk.malformedLines;
+        vector<SymbolId> locationIds = globalIds(chunk.locations, locationPool);
+        vector<SymbolId> departmentIds = globalIds(chunk.departments, departmentPool);
+        for (Event& event : chunk.events) {
+            event.location = locationIds[event.location];
+            event.department = departmentIds[event.department];
+            addImportedEvent(event, bookings, summary);
+        }
+        chunk.events = vector<Event>(); // Release parsed copies early
+    }
+
+    // Apply registrations in file order, against imported or existing events.
+    for (const ImportChunk& chunk : chunks) {
+        vector<SymbolId> courseIds = globalIds(chunk.courses, coursePool);
+        for (const ImportedRegistration& registration : chunk.registrations) {
+            EventHandle handle = eventNameIndex.find(registration.eventName);
+            if (handle == NO_EVENT) {
+                summary.rejectedRegistrations++;
+                continue;
+            }
+            Event& event = events[handle];
+            if (event.participants >= event.capacity) {
+                summary.rejectedRegistrations++;
+                continue;
+            }
+            appendRosterEntry(event, registration.participant.name, courseIds[registration.participant.course]);
+            summary.registrationsAdded++;
+        }
+    }
+}
+
+// Imports all records from 'path' into the store. Returns false if the file cannot be
+// read, or is a damaged binary export (the store is then unchanged).
+bool importEventsFromFile(const string& path, ImportSummary& summary) {
+    MappedFile file;
+    if (!file.open(path.c_str())) {
+        return false;
+    }
+    auto endsWith = [&](const string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".bin")) {
+        if (!importBinaryExport(file, summary)) {
+            return false;
+        }
+    } else {
+        importTextRecords(file, endsWith(".jsonl") || endsWith(".json"), summary);
+    }
+
+    // One index build for everything that was loaded, then persist it as a snapshot.
+    // The imported records are not logged, so if the snapshot fails the log no longer
+    // covers the store and must take no more records until a snapshot succeeds.
+    updateSecondaryDataStructures();
+    if (walFile != nullptr && !writeSnapshot()) {
+        suspendWal();
+        summary.saved = false;
+    }
+    return true;
+}
+
+// Function to add a new event.
+void addEvent() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- Adding a New UEvent --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    Event newEvent; // The ID is assigned by the event store on insertion.
+cout << setw(25) << left << "| Event Name:";
+cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer for getline
+getline(cin, newEvent.name);
+
+// Check if event name already exists using the hash index.
+if (eventNameIndex.contains(newEvent.name)) {
+cout << "\n⚠️ UEvent with name '" << newEvent.name << "' already exists. Please choose a different name. ⚠️" << endl;
+        return;
+ }
+
+    cout << setw(25) << left << "| Date (YYYY-MM-DD):";
+    // Dates and times are parsed into integers right here; invalid input is re-prompted.
+    // Input validation for date: it must be a real day inside the supported window.
+    string inputText;
+    while (!(cin >> inputText) || !parseDate(inputText, newEvent.date)) {
+        cout << "Invalid date. Please enter a date between " << MIN_EVENT_YEAR << " and "
+             << MAX_EVENT_YEAR << " as YYYY-MM-DD: ";
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    cout << setw(25) << left << "| Start Time (HH:MM):"; // NEW input for start time
+    while (!(cin >> inputText) || !parseTime(inputText, newEvent.startTime)) {
+        cout << "Invalid time. Please enter a 24-hour time as HH:MM: ";
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    cout << setw(25) << left << "| End Time (HH:MM):";   // NEW input for end time
+    while (!(cin >> inputText) || !parseTime(inputText, newEvent.endTime) ||
+           newEvent.endTime <= newEvent.startTime) {
+        cout << "Invalid time. Please enter a 24-hour time as HH:MM, after the start time: ";
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    
+    cout << setw(25) << left << "| Location:";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer for getline
+    string location;
+    getline(cin, location);
+    newEvent.location = locationPool.intern(location);
+
+    // Reject the booking if the location is already taken for any part of this time slot.
+    vector<EventHandle> conflicts =
+        findBookingConflicts(newEvent.location, newEvent.date, newEvent.startTime, newEvent.endTime);
+    if (!conflicts.empty()) {
+        cout << "\n⚠️ '" << location << "' is already booked on " << formatDate(newEvent.date)
+             << " during that time by: ⚠️" << endl;
+        for (EventHandle handle : conflicts) {
+            cout << "   - " << events[handle].name << " (" << formatTime(events[handle].startTime) << "-"
+                 << formatTime(events[handle].endTime) << ")" << endl;
+        }
+        return;
+    }
+
+    cout << setw(25) << left << "| Department:";
+    string department;
+    getline(cin, department);
+    newEvent.department = departmentPool.intern(department);
+    cout << setw(25) << left << "| Capacity:";
+    // Input validation for capacity
+    while (!(cin >> newEvent.capacity) || newEvent.capacity <= 0 || newEvent.capacity > MAX_EVENT_CAPACITY) {
+        cout << "Invalid capacity. Please enter a whole number from 1 to " << MAX_EVENT_CAPACITY << ": ";
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    }
+    newEvent.participants = 0; // New events start with 0 participants.
+    cout << string(45, '*') << endl;
+
+    // Incrementally update all secondary data structures and the date index.
+    insertEvent(newEvent);
+
+    cout << "\nUEvent '" << newEvent.name << "' added successfully! ✨" << endl;
+}
+
+// --- Table Rendering ---
+// Event tables are formatted into one reusable buffer and written with a few large
+// fwrite calls, instead of one iostream insertion per cell and a flush per row. Column
+// widths are fixed up front, numbers are formatted with to_chars and dates and times
+// with writeDate/writeTime (no temporary strings), and a cell wider than its column
+// overflows it unchanged, exactly as setw() did.
+//
+// Rows stream: the buffer is written out whenever it passes TABLE_FLUSH_BYTES, so a
+// listing fed row by row from an index walk is never held in memory as a whole. Paged
+// listings end the table after each page and begin a new one under the next title.
+const int TABLE_WIDTH = 109;
+const size_t TABLE_FLUSH_BYTES = 1 << 16;
+
+struct TableColumn {
+    const char* title;
+    int width;
+    bool alignRight;
+};
+
+const TableColumn EVENT_TABLE_COLUMNS[] = {
+    {"ID", 5, false},        {"Name", 20, false},       {"Date", 12, false},
+    {"Start", 9, false},     {"End", 9, false},         {"Location", 15, false},
+    {"Department", 15, false}, {"Capacity", 10, true},  {"Participants", 12, true},
+};
+const size_t EVENT_TABLE_COLUMN_COUNT = sizeof(EVENT_TABLE_COLUMNS) / sizeof(EVENT_TABLE_COLUMNS[0]);
+
+struct EventTableRenderer {
+    FILE* out;
+    string buffer;
+    size_t rows = 0; // Rows in the current table
+
+    explicit EventTableRenderer(FILE* output = stdout) : out(output) {
+        buffer.reserve(TABLE_FLUSH_BYTES + 4096);
+    }
+    ~EventTableRenderer() { flush(); }
+
+    // Starts a table under 'title'. The column header follows with the first row.
+    void begin(const string& title) {
+        buffer += '\n';
+        rule('=');
+        buffer += center("✨ --- " + title + " --- ✨", TABLE_WIDTH);
+        buffer += '\n';
+        rule('=');
+        rows = 0;
+    }
+
+    void add(EventHandle handle) {
+        if (rows++ == 0) {
+            for (size_t c = 0; c < EVENT_TABLE_COLUMN_COUNT; c++) {
+                cell(EVENT_TABLE_COLUMNS[c].title, c);
+            }
+            rule('-');
+        }
+        const Event& event = events[handle];
+        number(event.id, 0);
+        cell(event.name, 1);
+        char text[10];
+        cell(string_view(text, writeDate(text, event.date) - text), 2);
+        cell(string_view(text, writeTime(text, event.startTime) - text), 3);
+        cell(string_view(text, writeTime(text, event.endTime) - text), 4);
+        cell(locationPool.text(event.location), 5);
+        cell(departmentPool.text(event.department), 6);
+        number(event.capacity, 7);
+        number(event.participants, 8);
+        if (buffer.size() >= TABLE_FLUSH_BYTES) {
+            flush();
+        }
+    }
+
+    // Closes the table (or reports that it is empty) and writes everything out.
+    void end() {
+        if (rows == 0) {
+            buffer += center("No UEvents available. 😔", TABLE_WIDTH);
+            buffer += '\n';
+            rule('=');
+        } else {
+            rule('=');
+            buffer += '\n';
+        }
+        flush();
+    }
+
+    void flush() {
+        if (buffer.empty()) return;
+        cout.flush(); // Keep anything already sent through cout ahead of the table
+        fwrite(buffer.data(), 1, buffer.size(), out);
+        fflush(out);
+        buffer.clear();
+    }
+
+private:
+    void rule(char c) {
+        buffer.append(TABLE_WIDTH, c);
+        buffer += '\n';
+    }
+
+    // Appends the text of column 'c', padded to the column width, then the separator.
+    void cell(string_view text, size_t c) {
+        const TableColumn& column = EVENT_TABLE_COLUMNS[c];
+        size_t padding = text.size() < size_t(column.width) ? column.width - text.size() : 0;
+        if (column.alignRight) buffer.append(padding, ' ');
+        buffer.append(text.data(), text.size());
+        if (!column.alignRight) buffer.append(padding, ' ');
+        buffer += c + 1 < EVENT_TABLE_COLUMN_COUNT ? " | " : "\n";
+    }
+
+    void number(int64_t value, size_t c) {
+        char text[24];
+        char* last = to_chars(text, text + sizeof(text), value).ptr;
+        cell(string_view(text, last - text), c);
+    }
+};
+
+// Function to display events (reusable for different lists of events).
+void displayEventsList(const vector<EventHandle>& eventList, const string& title) {
+    EventTableRenderer table;
+    table.begin(title);
+    for (EventHandle handle : eventList) {
+        table.add(handle);
+    }
+    table.end();
+}
+
+// Shows a listing one table per page, asking before each further page. 'pageEvents'
+// returns the handles of a page, given its number. Reads the answers with getline.
+template <typename PageEvents>
+void displayEventPages(const string& title, size_t pageCount, PageEvents&& pageEvents) {
+    EventTableRenderer table;
+    for (size_t page = 0; page < pageCount; page++) {
+        table.begin(title + " (Page " + to_string(page + 1) + " of " + to_string(pageCount) + ")");
+        for (EventHandle handle : pageEvents(page)) {
+            table.add(handle);
+        }
+        table.end();
+        if (page + 1 < pageCount) {
+            cout << "Show next page? (y/n): ";
+            string answer;
+            getline(cin, answer);
+            if (answer != "y" && answer != "Y") {
+                break;
+            }
+        }
+    }
+}
+
+// Function to display all events, in the name order of the name trie.
+// Rows are streamed to the screen as the trie is walked.
+void displayAllEvents() {
+    clearScreen(); // Clear screen before displaying this option
+    EventTableRenderer table;
+    table.begin("All UEvents (Sorted by Name)");
+    forEachEventInNameOrder(0, [&](EventHandle handle) { table.add(handle); });
+    table.end();
+}
+
+// Prints "did you mean" suggestions from the name trie for a name that matched no event.
+void showNameSuggestions(const string& name) {
+    vector<EventHandle> suggestions = suggestEventNames(name, 5);
+    if (suggestions.empty()) return;
+    cout << "💡 Did you mean:" << endl;
+    for (EventHandle handle : suggestions) {
+        cout << "   - " << events[handle].name << endl;
+    }
+}
+
+// Function to search for an event by name using the hash name index.
+// On a miss, close or completing names are suggested from the name trie.
+void searchEvent() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- Search for a UEvent --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    cout << setw(30) << left << "| Enter UEvent name to search:";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string searchName;
+    getline(cin, searchName);
+    cout << string(45, '*') << endl;
+
+    EventHandle found = eventNameIndex.find(searchName); // Expected O(1) hash lookup.
+    if (found != NO_EVENT) {
+        cout << "\n✨ UEvent Found! ✨" << endl;
+        vector<EventHandle> foundEvent = {found}; // Found event, put into a vector for display.
+        displayEventsList(foundEvent, "Search Result for '" + searchName + "'");
+    } else {
+        cout << "\nUEvent '" << searchName << "' not found. 😔" << endl;
+        showNameSuggestions(searchName);
+    }
+    cout << endl;
+}
+
+// Function to register a participant for an event.
+// Uses the hash name index for quick event lookup.
+void registerParticipant() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- Register for a UEvent --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    cout << setw(30) << left << "| Enter the name of the UEvent:";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string eventName;
+    getline(cin, eventName);
+    cout << string(45, '*') << endl;
+
+    EventHandle found = eventNameIndex.find(eventName); // Expected O(1) event lookup.
+    if (found != NO_EVENT) {
+        Event* eventPtr = &events[found];
+        if (eventPtr->participants < eventPtr->capacity) {
+            Participant newParticipant;
+            cout << setw(30) << left << "| Enter participant's Name:";
+            getline(cin, newParticipant.name); // Using getline for names with spaces
+            cout << setw(30) << left << "| Enter participant's Course:";
+            string course;
+            getline(cin, course); // Using getline for courses with spaces
+            newParticipant.course = coursePool.intern(course);
+
+            addParticipant(found, newParticipant);
+
+            cout << "🎉 Successfully registered '" << newParticipant.name << "' from " << course
+                 << " for '" << eventPtr->name << "'! 🎉" << endl;
+        } else {
+            cout << "⚠️ UEvent '" << eventPtr->name << "' is already full. 😟" << endl;
+        }
+    } else {
+        cout << "UEvent '" << eventName << "' not found. 😔" << endl;
+        showNameSuggestions(eventName);
+    }
+    cout << endl;
+}
+
+// Returns the events of every department whose name contains 'filterDepartment',
+// sorted by event name.
+vector<EventHandle> findEventsByDepartment(const string& filterDepartment) {
+    vector<EventHandle> filteredEvents;
+    // Every department contains the empty string: the name trie is already that answer.
+    if (filterDepartment.empty()) {
+        return eventsInNameOrder();
+    }
+
+    // Look up the matching departments in the n-gram index.
+    vector<SymbolId> matches = matchDepartments(filterDepartment);
+    if (matches.size() == 1) {
+        return eventsByDepartment[matches[0]];
+    }
+
+    // Each department list is already sorted by name, so a k-way merge over the list
+    // heads yields the combined name order without re-sorting.
+    struct Head {
+        const EventHandle* next;
+        const EventHandle* end;
+    };
+    auto later = [](const Head& a, const Head& b) { return events[*a.next].name > events[*b.next].name; };
+    priority_queue<Head, vector<Head>, decltype(later)> heads(later);
+    size_t total = 0;
+    for (SymbolId id : matches) {
+        const vector<EventHandle>& list = eventsByDepartment[id];
+        if (!list.empty()) heads.push({list.data(), list.data() + list.size()});
+        total += list.size();
+    }
+    filteredEvents.reserve(total);
+    while (!heads.empty()) {
+        Head head = heads.top();
+        heads.pop();
+        filteredEvents.push_back(*head.next);
+        if (++head.next != head.end) heads.push(head);
+    }
+    return filteredEvents;
+}
+
+// Function to display events based on a specific department.
+// Uses the department n-gram index to find matching departments without scanning them all.
+void displayEventsByDepartment() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- UEvents by Department --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    cout << setw(30) << left << "| Enter the department to filter by:";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string filterDepartment;
+    getline(cin, filterDepartment);
+    cout << string(45, '*') << endl;
+
+    vector<EventHandle> filteredEvents = findEventsByDepartment(filterDepartment);
+    if (filteredEvents.empty()) {
+        cout << "No UEvents found with department containing '" << filterDepartment << "'. 😔" << endl;
+    } else {
+        displayEventsList(filteredEvents, "UEvents with department containing '" + filterDepartment + "'");
+    }
+    cout << endl;
+}
+
+
+// Number of events shown per page when listing events by date or a date range.
+const size_t DATE_RANGE_PAGE_SIZE = 20;
+
+// Function to display events sorted by date (then start time).
+// Streams pages straight from the maintained eventsByDate ordering: nothing is copied or
+// sorted, and the first page appears immediately regardless of how many events exist.
+void displayEventsSortedByDate() {
+    clearScreen(); // Clear screen before displaying this option
+    if (events.empty()) {
+        cout << "\n" << string(109, '=') << endl; // Increased width
+        cout << center("No UEvents available to sort. 😔", 109) << endl;
+        cout << string(109, '=') << endl;
+        return;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n'); // Clear buffer for the paging prompt
+    size_t pageCount = (events.size() + DATE_RANGE_PAGE_SIZE - 1) / DATE_RANGE_PAGE_SIZE;
+    DateOrderCursor cursor = dateOrderBegin();
+    displayEventPages("UEvents Sorted by Date", pageCount,
+                      [&](size_t) { return nextDateOrderPage(cursor, DATE_RANGE_PAGE_SIZE); });
+}
+
+// Searches for all events on a specific date.
+// Looks up the day's bucket in eventsByDate (O(log D)) instead of scanning all events.
+void searchEventsByDate() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- Search UEvents by Date --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    cout << setw(30) << left << "| Enter date (YYYY-MM-DD) to search:";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string searchDate;
+    getline(cin, searchDate);
+    cout << string(45, '*') << endl;
+
+    DayNumber day;
+    if (!parseDate(searchDate, day)) {
+        cout << "\n⚠️ Invalid date. Dates must be between " << MIN_EVENT_YEAR << " and " << MAX_EVENT_YEAR
+             << " in YYYY-MM-DD format. ⚠️" << endl;
+        return;
+    }
+
+    auto it = eventsByDate.find(day);
+    if (it == eventsByDate.end()) {
+        cout << "\nNo UEvents found on '" << searchDate << "'. 😔" << endl;
+    } else {
+        cout << "\n✨ UEvents found on '" << searchDate << "'! ✨" << endl;
+        // The bucket is already sorted by start time, giving the day's agenda.
+        displayEventsList(it->second, "UEvents on " + searchDate);
+    }
+    cout << endl;
+}
+
+
+// --- New Function: Query Events by Date Range (using Fenwick Tree and date buckets) ---
+// The Fenwick tree gives the total count in O(log D); each page of events is then
+// fetched from the date buckets, touching only the events inside the range.
+void queryEventsByDateRange() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- List UEvents by Date Range --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+
+    if (events.empty()) {
+        cout << "No events available to query by date. 😔" << endl;
+        cout << string(45, '*') << endl;
+        return;
+    }
+
+    cout << setw(30) << left << "| Enter Start Date (YYYY-MM-DD):";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string startDateStr;
+    getline(cin, startDateStr);
+
+    cout << setw(30) << left << "| Enter End Date (YYYY-MM-DD):";
+    string endDateStr;
+    getline(cin, endDateStr);
+    cout << string(45, '*') << endl;
+
+    // Convert date strings to their day numbers.
+    DayNumber startDay, endDay;
+    if (!parseDate(startDateStr, startDay) || !parseDate(endDateStr, endDay)) {
+        cout << "\n⚠️ Invalid date. Dates must be between " << MIN_EVENT_YEAR << " and " << MAX_EVENT_YEAR
+             << " in YYYY-MM-DD format. ⚠️" << endl;
+        return;
+    }
+
+    // Perform the Fenwick tree query: two O(log D) prefix sums.
+    int eventCount = countEventsInDayRange(startDay, endDay);
+    if (eventCount == 0) {
+        cout << "\nNo events found in the date range [" << startDateStr << " to " << endDateStr << "]. 😔" << endl;
+        return;
+    }
+
+    cout << "\nTotal UEvents in range [" << startDateStr << " to " << endDateStr << "]: " << eventCount << " ✨" << endl;
+
+    // Page through the matching events in date order.
+    size_t pageCount = (eventCount + DATE_RANGE_PAGE_SIZE - 1) / DATE_RANGE_PAGE_SIZE;
+    displayEventPages("UEvents from " + startDateStr + " to " + endDateStr, pageCount, [&](size_t page) {
+        return queryEventsInDateRange(startDay, endDay, page * DATE_RANGE_PAGE_SIZE, DATE_RANGE_PAGE_SIZE);
+    });
+    cout << endl;
+}
+
+// --- New Function: Booking Conflict Report (sweep over sorted schedules) ---
+// Lists every pair of events that are booked at the same location at overlapping times.
+void displayBookingConflicts() {
+    clearScreen(); // Clear screen before displaying this option
+    vector<pair<EventHandle, EventHandle>> conflicts = findAllBookingConflicts();
+
+    cout << "\n" << string(109, '=') << endl;
+    cout << center("⚠️ --- Booking Conflict Report --- ⚠️", 109) << endl;
+    cout << string(109, '=') << endl;
+    if (conflicts.empty()) {
+        cout << center("No overlapping bookings found. ✨", 109) << endl;
+        cout << string(109, '=') << endl;
+        return;
+    }
+    cout << setw(15) << left << "Location" << " | "
+         << setw(12) << left << "Date" << " | "
+         << setw(20) << left << "UEvent" << " | "
+         << setw(11) << left << "Time" << " | "
+         << setw(20) << left << "Overlaps With" << " | "
+         << setw(11) << left << "Time" << endl;
+    cout << string(109, '-') << endl;
+    for (const auto& conflict : conflicts) {
+        const Event& first = events[conflict.first];
+        const Event& second = events[conflict.second];
+        cout << setw(15) << left << locationPool.text(first.location) << " | "
+             << setw(12) << left << formatDate(first.date) << " | "
+             << setw(20) << left << first.name << " | "
+             << setw(11) << left << formatTime(first.startTime) + "-" + formatTime(first.endTime) << " | "
+             << setw(20) << left << second.name << " | "
+             << setw(11) << left << formatTime(second.startTime) + "-" + formatTime(second.endTime) << endl;
+    }
+    cout << string(109, '=') << endl;
+    cout << "Total conflicting pairs: " << conflicts.size() << endl;
+}
+
+// Seat usage of one department.
+struct DepartmentOccupancy {
+    size_t events = 0;
+    size_t fullEvents = 0;
+    size_t nearlyFullEvents = 0; // At 90% of capacity or more (including full ones)
+    int64_t seats = 0;
+    int64_t registered = 0;
+};
+
+// Totals seats and registrations per department (indexed by department id) in one pass
+// over the capacity, participant and department columns.
+vector<DepartmentOccupancy> computeDepartmentOccupancy() {
+    vector<DepartmentOccupancy> totals(departmentPool.size());
+    const size_t count = eventColumns.size();
+    const int32_t* capacity = eventColumns.capacity.data();
+    const int32_t* participants = eventColumns.participants.data();
+    const SymbolId* department = eventColumns.department.data();
+    for (size_t i = 0; i < count; i++) {
+        DepartmentOccupancy& total = totals[department[i]];
+        total.events++;
+        total.seats += capacity[i];
+        total.registered += participants[i];
+        total.fullEvents += participants[i] >= capacity[i];
+        total.nearlyFullEvents += static_cast<int64_t>(participants[i]) * 10 >= static_cast<int64_t>(capacity[i]) * 9;
+    }
+    return totals;
+}
+
+// --- New Function: Capacity & Occupancy Report (scan over the event columns) ---
+// Shows, per department, how many seats exist and how many are taken.
+void displayCapacityReport() {
+    clearScreen(); // Clear screen before displaying this option
+    vector<DepartmentOccupancy> totals = computeDepartmentOccupancy();
+
+    cout << "\n" << string(109, '=') << endl;
+    cout << center("🎟️ --- Capacity & Occupancy Report --- 🎟️", 109) << endl;
+    cout << string(109, '=') << endl;
+    if (events.empty()) {
+        cout << center("No UEvents available. 😔", 109) << endl;
+        cout << string(109, '=') << endl;
+        return;
+    }
+    cout << setw(25) << left << "Department" << " | "
+         << setw(8) << right << "UEvents" << " | "
+         << setw(12) << right << "Seats" << " | "
+         << setw(12) << right << "Registered" << " | "
+         << setw(8) << right << "Fill %" << " | "
+         << setw(8) << right << "Full" << " | "
+         << setw(8) << right << ">= 90%" << endl;
+    cout << string(109, '-') << endl;
+
+    // List departments alphabetically; the totals are indexed by department id.
+    vector<SymbolId> order;
+    for (SymbolId id = 0; id < totals.size(); id++) {
+        if (totals[id].events > 0) order.push_back(id);
+    }
+    sort(order.begin(), order.end(),
+         [](SymbolId a, SymbolId b) { return departmentPool.text(a) < departmentPool.text(b); });
+
+    DepartmentOccupancy overall;
+    auto printRow = [](const string& label, const DepartmentOccupancy& row) {
+        char fill[16];
+        snprintf(fill, sizeof(fill), "%.1f", row.seats > 0 ? 100.0 * row.registered / row.seats : 0.0);
+        cout << setw(25) << left << label << " | "
+             << setw(8) << right << row.events << " | "
+             << setw(12) << right << row.seats << " | "
+             << setw(12) << right << row.registered << " | "
+             << setw(8) << right << fill << " | "
+             << setw(8) << right << row.fullEvents << " | "
+             << setw(8) << right << row.nearlyFullEvents << endl;
+    };
+    for (SymbolId id : order) {
+        const DepartmentOccupancy& row = totals[id];
+        printRow(departmentPool.text(id), row);
+        overall.events += row.events;
+        overall.fullEvents += row.fullEvents;
+        overall.nearlyFullEvents += row.nearlyFullEvents;
+        overall.seats += row.seats;
+        overall.registered += row.registered;
+    }
+    cout << string(109, '-') << endl;
+    printRow("All departments", overall);
+    cout << string(109, '=') << endl;
+
+    // The events close to selling out, found with a column scan.
+    vector<EventHandle> nearlyFull = selectedHandles(selectEventsAtOccupancy(90));
+    if (!nearlyFull.empty()) {
+        size_t total = nearlyFull.size();
+        if (total > DATE_RANGE_PAGE_SIZE) nearlyFull.resize(DATE_RANGE_PAGE_SIZE);
+        displayEventsList(nearlyFull, "UEvents at 90% Capacity or More (" + to_string(total) + ")");
+        if (total > nearlyFull.size()) {
+            cout << "... and " << total - nearlyFull.size() << " more." << endl;
+        }
+    }
+}
+
+// Imports a file and prints what was loaded, and a warning if it could not be saved.
+// Returns false if the file could not be read.
+bool runImport(const string& path) {
+    ImportSummary summary;
+    auto started = chrono::steady_clock::now();
+    if (!importEventsFromFile(path, summary)) {
+        cout << "\n⚠️ Could not read '" << path << "' (missing, or a damaged binary export). ⚠️" << endl;
+        return false;
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - started);
+    cout << "\n✨ Imported " << summary.eventsAdded << " UEvents and " << summary.registrationsAdded
+         << " registrations in " << elapsed.count() << " ms. ✨" << endl;
+    if (summary.malformedLines > 0) {
+        cout << "   Skipped " << summary.malformedLines << " malformed lines." << endl;
+    }
+    if (summary.duplicateEvents > 0) {
+        cout << "   Skipped " << summary.duplicateEvents << " UEvents whose names already exist." << endl;
+    }
+    if (summary.conflictingEvents > 0) {
+        cout << "   Skipped " << summary.conflictingEvents
+             << " UEvents whose location is already booked during that time." << endl;
+    }
+    if (summary.rejectedRegistrations > 0) {
+        cout << "   Skipped " << summary.rejectedRegistrations << " registrations for unknown or full UEvents." << endl;
+    }
+    if (!summary.saved) {
+        cout << "⚠️ The import was not saved: it is only in memory until a snapshot succeeds. ⚠️" << endl;
+    }
+    return true;
+}
+
+// --- New Function: Bulk Import ---
+// Loads events and registrations from a CSV, JSON-lines or binary export file (see "Bulk Import" above).
+void importEvents() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- Import UEvents from File --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    cout << setw(30) << left << "| Enter file path (.csv/.jsonl/.bin):";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string path;
+    getline(cin, path);
+    cout << string(45, '*') << endl;
+    runImport(path);
+    cout << endl;
+}
+
+
+// --- Batch Mode ---
+// Runs a stream of commands without prompts or screen clears, for scripts and benchmarks.
+// Each input line is one command with tab-separated fields:
+//
+//   add         <name> <YYYY-MM-DD> <HH:MM start> <HH:MM end> <location> <department> <capacity>
+//   register    <event name> <participant name> <course>
+//   search      <event name>
+//   search-date <YYYY-MM-DD>
+//   range-count <start YYYY-MM-DD> <end YYYY-MM-DD>
+//   range       <start YYYY-MM-DD> <end YYYY-MM-DD> <offset> <limit>
+//   list-dept   <department substring>
+//   complete    <name prefix> <limit>
+//   suggest     <misspelled name> <limit>
+//   free-seats  <department>
+//   near-full   <percent of capacity>
+//
+// Empty lines and lines starting with '#' are ignored. Every command produces exactly one
+// JSON object on its own output line with "op" and "ok" fields, plus either the result or
+// an "error" message. Commands use the same data structures as the interactive menu.
+
+// Largest <limit> a command accepts, so one request cannot ask for an unbounded response.
+const size_t MAX_BATCH_LIMIT = 100000;
+
+// Appends 'text' to 'out' as a quoted JSON string.
+// Runs of characters that need no escaping are copied in one append.
+void appendJsonString(string& out, string_view text) {
+    out += '"';
+    size_t run = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (c != '"' && c != '\\' && static_cast<unsigned char>(c) >= 0x20) continue;
+        out.append(text.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            }
+        }
+    }
+    out.append(text.data() + run, text.size() - run);
+    out += '"';
+}
+
+// Appends an event as a JSON object.
+void appendEventJson(string& out, EventHandle handle) {
+    const Event& event = events[handle];
+    out += "{\"id\":" + to_string(event.id) + ",\"name\":";
+    appendJsonString(out, event.name);
+    out += ",\"date\":\"" + formatDate(event.date) + "\",\"start\":\"" + formatTime(event.startTime) +
+           "\",\"end\":\"" + formatTime(event.endTime) + "\",\"location\":";
+    appendJsonString(out, locationPool.text(event.location));
+    out += ",\"department\":";
+    appendJsonString(out, departmentPool.text(event.department));
+    out += ",\"capacity\":" + to_string(event.capacity) + ",\"participants\":" + to_string(event.participants) + "}";
+}
+
+// Appends a list of events as a JSON array.
+void appendEventListJson(string& out, const vector<EventHandle>& eventList) {
+    out += '[';
+    for (size_t i = 0; i < eventList.size(); i++) {
+        if (i > 0) out += ',';
+        appendEventJson(out, eventList[i]);
+    }
+    out += ']';
+}
+
+// Splits a batch command line into its tab-separated fields.
+void splitTabFields(const string& line, vector<string>& fields) {
+    fields.clear();
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == string::npos ? string::npos : tab - start));
+        if (tab == string::npos) break;
+        start = tab + 1;
+    }
+}
+
+// Executes one batch command and appends its JSON result line to 'out'.
+void executeBatchCommand(const vector<string>& fields, string& out) {
+    const string& op = fields[0];
+    size_t argCount = fields.size() - 1;
+    out += "{\"op\":";
+    appendJsonString(out, op);
+    auto fail = [&](const string& message) {
+        out += ",\"ok\":false,\"error\":";
+        appendJsonString(out, message);
+        out += "}\n";
+    };
+    auto parseRange = [&](DayNumber& first, DayNumber& last) {
+        return parseDate(fields[1], first) && parseDate(fields[2], last);
+    };
+
+    if (op == "add" && argCount == 7) {
+        Event newEvent;
+        if (!makeImportedEvent(fields[1], fields[2], fields[3], fields[4], fields[5], fields[6], fields[7], locationPool,
+                               departmentPool, newEvent)) {
+            return fail("invalid field");
+        }
+        if (eventNameIndex.contains(newEvent.name)) {
+            return fail("duplicate name");
+        }
+        if (!findBookingConflicts(newEvent.location, newEvent.date, newEvent.startTime, newEvent.endTime).empty()) {
+            return fail("booking conflict");
+        }
+        EventHandle handle = insertEvent(newEvent);
+        out += ",\"ok\":true,\"id\":" + to_string(events[handle].id) + "}\n";
+    } else if (op == "register" && argCount == 3) {
+        EventHandle handle = eventNameIndex.find(fields[1]);
+        if (handle == NO_EVENT) {
+            return fail("event not found");
+        }
+        if (!addParticipant(handle, {fields[2], coursePool.intern(fields[3])})) {
+            return fail("event full");
+        }
+        out += ",\"ok\":true,\"participants\":" + to_string(events[handle].participants) + "}\n";
+    } else if (op == "search" && argCount == 1) {
+        EventHandle handle = eventNameIndex.find(fields[1]);
+        if (handle == NO_EVENT) {
+            return fail("event not found");
+        }
+        out += ",\"ok\":true,\"event\":";
+        appendEventJson(out, handle);
+        out += "}\n";
+    } else if (op == "search-date" && argCount == 1) {
+        DayNumber day;
+        if (!parseDate(fields[1], day)) {
+            return fail("invalid date");
+        }
+        auto it = eventsByDate.find(day);
+        out += ",\"ok\":true,\"events\":";
+        appendEventListJson(out, it == eventsByDate.end() ? vector<EventHandle>() : it->second);
+        out += "}\n";
+    } else if (op == "range-count" && argCount == 2) {
+        DayNumber first, last;
+        if (!parseRange(first, last)) {
+            return fail("invalid date");
+        }
+        out += ",\"ok\":true,\"count\":" + to_string(countEventsInDayRange(first, last)) + "}\n";
+    } else if (op == "range" && argCount == 4) {
+        DayNumber first, last;
+        if (!parseRange(first, last)) {
+            return fail("invalid date");
+        }
+        size_t offset, limit;
+        if (!parseInteger<size_t>(fields[3], offset, 0, numeric_limits<size_t>::max())) {
+            return fail("invalid offset");
+        }
+        if (!parseInteger<size_t>(fields[4], limit, 0, MAX_BATCH_LIMIT)) {
+            return fail("invalid limit");
+        }
+        out += ",\"ok\":true,\"events\":";
+        appendEventListJson(out, queryEventsInDateRange(first, last, offset, limit));
+        out += "}\n";
+    } else if (op == "list-dept" && argCount == 1) {
+        out += ",\"ok\":true,\"events\":";
+        appendEventListJson(out, findEventsByDepartment(fields[1]));
+        out += "}\n";
+    } else if (op == "free-seats" && argCount == 1) {
+        SymbolId department = departmentPool.find(fields[1]);
+        out += ",\"ok\":true,\"events\":";
+        appendEventListJson(out, department == NO_SYMBOL ? vector<EventHandle>()
+                                                         : selectedHandles(selectEventsWithFreeSeats(department)));
+        out += "}\n";
+    } else if (op == "near-full" && argCount == 1) {
+        char* parsedEnd = nullptr;
+        long percent = strtol(fields[1].c_str(), &parsedEnd, 10);
+        if (fields[1].empty() || *parsedEnd != '\0' || percent < 0 || percent > 100) {
+            return fail("invalid percent");
+        }
+        out += ",\"ok\":true,\"events\":";
+        appendEventListJson(out, selectedHandles(selectEventsAtOccupancy(static_cast<int>(percent))));
+        out += "}\n";
+    } else if ((op == "complete" || op == "suggest") && argCount == 2) {
+        size_t limit;
+        if (!parseInteger<size_t>(fields[2], limit, 1, MAX_BATCH_LIMIT)) {
+            return fail("invalid limit");
+        }
+        vector<EventHandle> matches =
+            op == "complete" ? completeEventName(fields[1], limit) : suggestEventNames(fields[1], limit);
+        out += ",\"ok\":true,\"names\":[";
+        for (size_t i = 0; i < matches.size(); i++) {
+            if (i > 0) out += ',';
+            appendJsonString(out, events[matches[i]].name);
+        }
+        out += "]}\n";
+    } else {
+        fail("unknown command or wrong number of fields");
+    }
+}
+
+// Runs every command from 'input', writing one JSON line per command to stdout.
+// Output is written in large blocks; a throughput summary goes to stderr at the end.
+void runBatch(istream& input) {
+    string line, out;
+    vector<string> fields;
+    size_t commandCount = 0;
+    auto started = chrono::steady_clock::now();
+    while (getline(input, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        splitTabFields(line, fields);
+        executeBatchCommand(fields, out);
+        commandCount++;
+        if (out.size() >= (1 << 16)) {
+            fwrite(out.data(), 1, out.size(), stdout);
+            out.clear();
+            checkpointIfDue();
+        }
+    }
+    fwrite(out.data(), 1, out.size(), stdout);
+    fflush(stdout);
+    checkpointIfDue();
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+    fprintf(stderr, "%zu commands in %.3f s (%.0f commands/s)\n", commandCount, seconds,
+            seconds > 0 ? commandCount / seconds : 0.0);
+}
+
+// --- Export (CSV / JSON Lines / Binary) ---
+// Dumps every event and its roster, in ID order, straight from the event store: records
+// are appended to one reusable buffer that is written out whenever it passes
+// EXPORT_FLUSH_BYTES, so an export of any size holds one block in memory and never
+// builds a list of events or rows. Numbers, dates and times are formatted in place.
+//
+// The format is chosen by extension, as for imports (".jsonl"/".json", ".bin", CSV
+// otherwise). CSV and JSON lines use the import record layouts (see "Bulk Import"), and
+// the importer also reads binary exports, so any export can be imported again; each
+// event record is followed by one register record per participant, in registration order.
+//
+//   CSV:        a "type,name,date,start,end,location,department,capacity" header, then
+//               event,... and register,... records. Fields containing a comma, a quote
+//               or a line break are double-quoted; the line break stays in the quotes.
+//   JSON lines: event records also carry "id" and "participants" (ignored on import).
+//   Binary:     magic "UEVEXPT1", u32 event count, the events in ID order as encoded
+//               in snapshots (encodeEvent), u32 FNV-1a checksum of everything after the
+//               magic. Integers are in host byte order.
+const size_t EXPORT_FLUSH_BYTES = 1 << 20;
+
+enum ExportFormat { EXPORT_CSV, EXPORT_JSON_LINES, EXPORT_BINARY };
+
+// Picks the export format from a file name.
+ExportFormat exportFormatForPath(const string& path) {
+    auto endsWith = [&](const string& suffix) {
+        return path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".jsonl") || endsWith(".json")) return EXPORT_JSON_LINES;
+    if (endsWith(".bin")) return EXPORT_BINARY;
+    return EXPORT_CSV;
+}
+
+// Appends 'text' as a CSV field, quoting it only if it has to be.
+void appendCsvField(string& out, string_view text) {
+    bool plain = true;
+    for (char c : text) {
+        plain = plain && c != ',' && c != '"' && c != '\r' && c != '\n';
+    }
+    if (plain) {
+        out.append(text.data(), text.size());
+        return;
+    }
+    out += '"';
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+// Appends an integer in decimal.
+void appendNumber(string& out, int64_t value) {
+    char text[24];
+    out.append(text, to_chars(text, text + sizeof(text), value).ptr - text);
+}
+
+struct ExportSummary {
+    size_t events = 0;
+    size_t registrations = 0;
+    uint64_t bytes = 0;
+};
+
+struct EventExporter {
+    FILE* out; // Null discards the output (used to time the formatting alone)
+    ExportFormat format;
+    string buffer;
+    uint32_t checksum = 2166136261u; // Binary format only
+    ExportSummary summary;
+    bool ok = true;
+
+    EventExporter(FILE* output, ExportFormat exportFormat) : out(output), format(exportFormat) {
+        buffer.reserve(EXPORT_FLUSH_BYTES + (1 << 16));
+    }
+
+    // Writes the header for a dump of 'count' events.
+    void begin(size_t count) {
+        if (format == EXPORT_CSV) {
+            buffer += "type,name,date,start,end,location,department,capacity\n";
+        } else if (format == EXPORT_BINARY) {
+            write(EXPORT_MAGIC, sizeof(EXPORT_MAGIC));
+            putValue<uint32_t>(buffer, count);
+        }
+    }
+
+    void add(EventHandle handle) {
+        const Event& event = events[handle];
+        int registered = event.participants;
+        if (format == EXPORT_CSV) {
+            addCsv(event, registered);
+        } else if (format == EXPORT_JSON_LINES) {
+            addJson(event, registered);
+        } else {
+            encodeEvent(buffer, event);
+        }
+        summary.events++;
+        summary.registrations += registered;
+        if (buffer.size() >= EXPORT_FLUSH_BYTES) {
+            flush();
+        }
+    }
+
+    // Writes the trailer and everything still buffered. Returns false if any write failed.
+    bool finish() {
+        flush();
+        if (format == EXPORT_BINARY) {
+            write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        }
+        return ok;
+    }
+
+private:
+    void addCsv(const Event& event, int registered) {
+        char text[10];
+        buffer += "event,";
+        appendCsvField(buffer, event.name);
+        buffer += ',';
+        buffer.append(text, writeDate(text, event.date) - text);
+        buffer += ',';
+        buffer.append(text, writeTime(text, event.startTime) - text);
+        buffer += ',';
+        buffer.append(text, writeTime(text, event.endTime) - text);
+        buffer += ',';
+        appendCsvField(buffer, locationPool.text(event.location));
+        buffer += ',';
+        appendCsvField(buffer, departmentPool.text(event.department));
+        buffer += ',';
+        appendNumber(buffer, event.capacity);
+        buffer += '\n';
+        for (int i = 0; i < registered; i++) {
+            buffer += "register,";
+            appendCsvField(buffer, event.name);
+            buffer += ',';
+            appendCsvField(buffer, rosterName(event.roster[i]));
+            buffer += ',';
+            appendCsvField(buffer, coursePool.text(event.roster[i].course));
+            buffer += '\n';
+        }
+    }
+
+    void addJson(const Event& event, int registered) {
+        char text[10];
+        buffer += "{\"type\":\"event\",\"id\":";
+        appendNumber(buffer, event.id);
+        buffer += ",\"name\":";
+        appendJsonString(buffer, event.name);
+        buffer += ",\"date\":\"";
+        buffer.append(text, writeDate(text, event.date) - text);
+        buffer += "\",\"start\":\"";
+        buffer.append(text, writeTime(text, event.startTime) - text);
+        buffer += "\",\"end\":\"";
+        buffer.append(text, writeTime(text, event.endTime) - text);
+        buffer += "\",\"location\":";
+        appendJsonString(buffer, locationPool.text(event.location));
+        buffer += ",\"department\":";
+        appendJsonString(buffer, departmentPool.text(event.department));
+        buffer += ",\"capacity\":";
+        appendNumber(buffer, event.capacity);
+        buffer += ",\"participants\":";
+        appendNumber(buffer, registered);
+        buffer += "}\n";
+        for (int i = 0; i < registered; i++) {
+            buffer += "{\"type\":\"register\",\"event\":";
+            appendJsonString(buffer, event.name);
+            buffer += ",\"name\":";
+            appendJsonString(buffer, rosterName(event.roster[i]));
+            buffer += ",\"course\":";
+            appendJsonString(buffer, coursePool.text(event.roster[i].course));
+            buffer += "}\n";
+        }
+    }
+
+    void flush() {
+        if (format == EXPORT_BINARY) {
+            checksum = fnv1a(buffer.data(), buffer.size(), checksum);
+        }
+        write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    void write(const char* data, size_t size) {
+        if (out != nullptr && ok) {
+            ok = fwrite(data, 1, size, out) == size;
+        }
+        summary.bytes += size;
+    }
+};
+
+// Writes every event and roster to 'out' in the given format. Returns false if a write failed.
+bool writeEventExport(FILE* out, ExportFormat format, ExportSummary& summary) {
+    EventExporter exporter(out, format);
+    exporter.begin(events.size());
+    for (EventHandle h = 0; h < events.size(); h++) {
+        exporter.add(h);
+    }
+    bool written = exporter.finish();
+    summary = exporter.summary;
+    return written;
+}
+
+// Exports the store to 'path', in the format its extension names. Returns false if the
+// file cannot be written.
+bool exportEventsToFile(const string& path, ExportSummary& summary) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written = writeEventExport(file, exportFormatForPath(path), summary);
+    return (fclose(file) == 0) && written;
+}
+
+// Exports to a file and prints what was written. Returns false if the export failed.
+bool runExport(const string& path) {
+    ExportSummary summary;
+    auto started = chrono::steady_clock::now();
+    if (!exportEventsToFile(path, summary)) {
+        cout << "\n⚠️ Could not write '" << path << "'. ⚠️" << endl;
+        return false;
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - started);
+    char rate[64];
+    snprintf(rate, sizeof(rate), "%.1f MB in %lld ms (%.0f MB/s)", summary.bytes / 1e6,
+             static_cast<long long>(elapsed.count()), summary.bytes / 1e3 / max<int64_t>(1, elapsed.count()));
+    cout << "\n✨ Exported " << summary.events << " UEvents and " << summary.registrations << " registrations: "
+         << rate << ". ✨" << endl;
+    return true;
+}
+
+// --- New Function: Export ---
+// Writes every event and roster to a CSV, JSON-lines or binary file (see "Export" above).
+void exportEvents() {
+    clearScreen(); // Clear screen before displaying this option
+    cout << "\n" << string(45, '*') << endl;
+    cout << center("* --- Export UEvents to File --- *", 45) << endl;
+    cout << string(45, '*') << endl;
+    cout << setw(30) << left << "| Enter file path (.csv/.jsonl/.bin):";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string path;
+    getline(cin, path);
+    cout << string(45, '*') << endl;
+    runExport(path);
+    cout << endl;
+}
+
+// --- Micro-Benchmark Suite ---
+// Builds synthetic calendars of increasing size in memory and times the core store
+// operations on each, reporting throughput, median/99th-percentile latency and the
+// resident memory used per event. Nothing is read from or written to disk.
+//
+//   final --bench [--events 1000,100000,...] [--days D] [--departments K]
+//                 [--participants P] [--seed S]
+//
+// --days is the spread of event dates (starting 2024-01-01), --departments the number of
+// distinct departments and --participants the number of registrations made per event.
+
+// Upper bound on the threads a benchmark option may ask for.
+const size_t MAX_BENCH_THREADS = 1024;
+
+// Sorts event handles by date (stable: events on the same date keep their order) with
+// the parallel merge sort on the shared worker pool. No menu path sorts by date any more,
+// as the date buckets keep that order, so only the benchmark uses it, as the baseline
+// for the key-extraction sorts. The caller owns the scratch buffer, so repeated timed
+// sorts allocate nothing and concurrent callers share no state.
+void mergeSortEventsByDate(vector<EventHandle>& eventList, vector<EventHandle>& scratch) {
+    parallelMergeSort(eventList, scratch,
+                      [](EventHandle a, EventHandle b) { return events[a].date < events[b].date; },
+                      sharedWorkerPool());
+}
+
+// Day numbers fit in this many bits, so a date key needs only two 11-bit radix passes.
+const int DATE_KEY_BITS = 22;
+const int RADIX_BITS = 11;
+static_assert(DAY_RANGE < (1 << DATE_KEY_BITS), "date keys must fit in DATE_KEY_BITS");
+
+// Buffers for sortEventsByDate(), owned by the caller so repeated sorts allocate nothing.
+struct RadixSortBuffers {
+    vector<uint64_t> keys;
+    vector<uint64_t> scratch;
+    vector<EventHandle> permuted;
+};
+
+// Sorts event handles by date (stable) with an LSD radix sort over packed keys:
+// the day number sits in the upper 32 bits and the original position in the lower 32,
+// which also serves as the index for the final permutation. Like mergeSortEventsByDate(),
+// only the benchmark uses it.
+void sortEventsByDate(vector<EventHandle>& eventList, RadixSortBuffers& buffers) {
+    const size_t n = eventList.size();
+    vector<uint64_t>& radixKeys = buffers.keys;
+    vector<uint64_t>& radixScratch = buffers.scratch;
+    vector<EventHandle>& permutedHandles = buffers.permuted;
+    radixKeys.resize(n);
+    radixScratch.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        radixKeys[i] = (static_cast<uint64_t>(events[eventList[i]].date) << 32) | i;
+    }
+    const uint64_t mask = (1 << RADIX_BITS) - 1;
+    for (int shift = 32; shift < 32 + DATE_KEY_BITS; shift += RADIX_BITS) {
+        size_t offsets[1 << RADIX_BITS] = {};
+        for (uint64_t key : radixKeys) {
+            offsets[(key >> shift) & mask]++;
+        }
+        size_t total = 0;
+        for (size_t& offset : offsets) {
+            size_t count = offset;
+            offset = total;
+            total += count;
+        }
+        for (uint64_t key : radixKeys) {
+            radixScratch[offsets[(key >> shift) & mask]++] = key;
+        }
+        radixKeys.swap(radixScratch);
+    }
+    permutedHandles.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        permutedHandles[i] = eventList[static_cast<uint32_t>(radixKeys[i])];
+    }
+    eventList.swap(permutedHandles);
+}
+
+struct BenchConfig {
+    vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+    int days = 1095;
+    int departments = 50;
+    int participants = 10;
+    uint64_t seed = 42;
+};
+
+// Collects per-operation latencies for one benchmarked operation and prints a report row.
+struct LatencyRecorder {
+    vector<double> samplesNs;
+
+    // Times one call of 'operation'.
+    template <typename F>
+    void measure(F&& operation) {
+        auto started = chrono::steady_clock::now();
+        operation();
+        samplesNs.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - started).count());
+    }
+
+    // Prints operation count, throughput, and p50/p99 latency in microseconds.
+    void report(const char* name) {
+        if (samplesNs.empty()) return;
+        double totalNs = 0;
+        for (double sample : samplesNs) totalNs += sample;
+        sort(samplesNs.begin(), samplesNs.end());
+        double p50 = samplesNs[samplesNs.size() / 2];
+        double p99 = samplesNs[min(samplesNs.size() - 1, samplesNs.size() * 99 / 100)];
+        printf("  %-24s %12zu %14.0f %12.3f %12.3f\n", name, samplesNs.size(),
+               samplesNs.size() / (totalNs / 1e9), p50 / 1e3, p99 / 1e3);
+        samplesNs.clear();
+    }
+};
+
+// Returns the resident set size of this process in bytes, or 0 where unavailable.
+size_t residentMemoryBytes() {
+#ifdef __linux__
+    ifstream statm("/proc/self/statm");
+    size_t totalPages = 0, residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
+
+// Runs the whole suite for one calendar size.
+void runBenchmarkSize(const BenchConfig& config, size_t eventCount) {
+    mt19937_64 rng(config.seed);
+    const DayNumber firstDay = daysFromCivil(2024, 1, 1);
+    const int locationCount = config.departments * 10;
+    auto randomDay = [&]() { return firstDay + static_cast<DayNumber>(rng() % config.days); };
+
+    clearEventStore();
+    size_t memoryBefore = residentMemoryBytes();
+    printf("\n%zu events, %d days, %d departments, %d participants per event\n", eventCount, config.days,
+           config.departments, config.participants);
+    printf("  %-24s %12s %14s %12s %12s\n", "operation", "ops", "ops/sec", "p50 (us)", "p99 (us)");
+
+    // Insert: unique names in scattered order (i * odd constant is a bijection on 32 bits).
+    LatencyRecorder recorder;
+    Event event;
+    for (size_t i = 0; i < eventCount; i++) {
+        event.name = "Event " + to_string(static_cast<uint32_t>(i * 2654435761u));
+        event.date = randomDay();
+        event.startTime = rng() % (23 * 60);
+        event.endTime = event.startTime + 30 + rng() % 30;
+        event.location = locationPool.intern("Room " + to_string(rng() % locationCount));
+        event.department = departmentPool.intern("Department " + to_string(rng() % config.departments));
+        event.capacity = config.participants + 10;
+        event.participants = 0;
+        recorder.measure([&]() { insertEvent(event); });
+    }
+    recorder.report("insertEvent");
+    size_t memoryAfterInsert = residentMemoryBytes();
+
+    // Full index rebuild, as done at startup and after bulk imports.
+    recorder.measure([&]() { updateSecondaryDataStructures(); });
+    recorder.report("full index rebuild");
+
+    // Registrations for every event.
+    Participant participant{"Benchmark Participant", coursePool.intern("BSCS")};
+    for (EventHandle h = 0; h < events.size(); h++) {
+        for (int p = 0; p < config.participants; p++) {
+            recorder.measure([&]() { addParticipant(h, participant); });
+        }
+    }
+    recorder.report("addParticipant");
+    size_t memoryAfterRegister = residentMemoryBytes();
+
+    // Point lookups; capped so the largest calendars still finish quickly.
+    const size_t lookupCount = min<size_t>(eventCount, 1000000);
+    volatile size_t sink = 0;
+    for (size_t i = 0; i < lookupCount; i++) {
+        string name = "Event " + to_string(static_cast<uint32_t>((rng() % eventCount) * 2654435761u));
+        recorder.measure([&]() { sink = sink + eventNameIndex.contains(name); });
+    }
+    recorder.report("name lookup");
+
+    const size_t trieQueries = min<size_t>(lookupCount, 100000);
+    for (size_t i = 0; i < trieQueries; i++) {
+        string prefix = "Event " + to_string(static_cast<uint32_t>((rng() % eventCount) * 2654435761u)).substr(0, 4);
+        recorder.measure([&]() { sink = sink + completeEventName(prefix, 10).size(); });
+    }
+    recorder.report("prefix completion (10)");
+
+    for (size_t i = 0; i < trieQueries; i++) {
+        // A one-character typo in an existing name.
+        string name = "Event " + to_string(static_cast<uint32_t>((rng() % eventCount) * 2654435761u));
+        name[6 + rng() % (name.size() - 6)] = 'x';
+        recorder.measure([&]() { sink = sink + fuzzyFindEventNames(name, 2, 5).size(); });
+    }
+    recorder.report("fuzzy lookup (2 edits)");
+
+    for (size_t i = 0; i < lookupCount; i++) {
+        DayNumber day = randomDay();
+        recorder.measure([&]() {
+            auto it = eventsByDate.find(day);
+            sink = sink + (it == eventsByDate.end() ? 0 : it->second.size());
+        });
+    }
+    recorder.report("search by date");
+
+    for (size_t i = 0; i < lookupCount; i++) {
+        DayNumber first = randomDay();
+        DayNumber last = first + rng() % 90;
+        recorder.measure([&]() { sink = sink + countEventsInDayRange(first, last); });
+    }
+    recorder.report("date range count");
+
+    for (size_t i = 0; i < lookupCount; i++) {
+        DayNumber first = randomDay();
+        recorder.measure([&]() { sink = sink + queryEventsInDateRange(first, first + 6, 0, 20).size(); });
+    }
+    recorder.report("date range page (7d/20)");
+
+    for (size_t i = 0; i < lookupCount; i++) {
+        recorder.measure([&]() {
+            DateOrderCursor cursor = dateOrderBegin();
+            sink = sink + nextDateOrderPage(cursor, 20).size();
+        });
+    }
+    recorder.report("first page by date (20)");
+
+    const size_t departmentQueries = max<size_t>(10, min<size_t>(1000, 10000000 / eventCount));
+    for (size_t i = 0; i < departmentQueries; i++) {
+        string filter = "Department " + to_string(rng() % config.departments);
+        recorder.measure([&]() { sink = sink + findEventsByDepartment(filter).size(); });
+    }
+    recorder.report("department filter");
+
+    const size_t reportRuns = max<size_t>(5, min<size_t>(100, 10000000 / eventCount));
+    for (size_t i = 0; i < reportRuns; i++) {
+        recorder.measure([&]() { sink = sink + computeDepartmentOccupancy().size(); });
+    }
+    recorder.report("occupancy report scan");
+
+    // Column predicate scans, with the AVX2 kernels (when available) and without.
+    const bool simdAvailable = simdKernelsEnabled;
+    for (int pass = simdAvailable ? 0 : 1; pass < 2; pass++) {
+        simdKernelsEnabled = pass == 0;
+        const char* suffix = pass == 0 ? " (avx2)" : " (scalar)";
+        for (size_t i = 0; i < reportRuns; i++) {
+            DayNumber day = randomDay();
+            recorder.measure([&]() { sink = sink + countSelected(selectEventsOnDate(day)); });
+        }
+        recorder.report((string("date scan") + suffix).c_str());
+        for (size_t i = 0; i < reportRuns; i++) {
+            SymbolId department = departmentPool.find("Department " + to_string(rng() % config.departments));
+            recorder.measure([&]() { sink = sink + countSelected(selectEventsWithFreeSeats(department)); });
+        }
+        recorder.report((string("free seats scan") + suffix).c_str());
+        for (size_t i = 0; i < reportRuns; i++) {
+            recorder.measure([&]() { sink = sink + countSelected(selectEventsAtOccupancy(90)); });
+        }
+        recorder.report((string(">= 90% full scan") + suffix).c_str());
+    }
+    simdKernelsEnabled = simdAvailable;
+
+    // Full sort by date of all events; the copy is made outside the timed region.
+    vector<EventHandle> allHandles(events.size());
+    for (EventHandle h = 0; h < events.size(); h++) allHandles[h] = h;
+    const size_t sortRepeats = max<size_t>(1, min<size_t>(20, 1000000 / eventCount));
+    vector<EventHandle> dateSortScratch(allHandles.size());
+    for (size_t i = 0; i < sortRepeats; i++) {
+        vector<EventHandle> toSort = allHandles;
+        recorder.measure([&]() { mergeSortEventsByDate(toSort, dateSortScratch); });
+    }
+    recorder.report("merge sort by date");
+    RadixSortBuffers radixBuffers;
+    for (size_t i = 0; i < sortRepeats; i++) {
+        vector<EventHandle> toSort = allHandles;
+        recorder.measure([&]() { sortEventsByDate(toSort, radixBuffers); });
+    }
+    recorder.report("radix key sort by date");
+    for (size_t i = 0; i < sortRepeats; i++) {
+        vector<EventHandle> toSort = allHandles;
+        recorder.measure([&]() { sortEventsByName(toSort); });
+    }
+    recorder.report("prefix key sort by name");
+
+    // Full exports, formatted but not written anywhere.
+    const char* exportNames[] = {"export csv", "export json lines", "export binary"};
+    for (ExportFormat format : {EXPORT_CSV, EXPORT_JSON_LINES, EXPORT_BINARY}) {
+        ExportSummary summary;
+        for (size_t i = 0; i < sortRepeats; i++) {
+            recorder.measure([&]() { writeEventExport(nullptr, format, summary); });
+        }
+        double totalNs = 0;
+        for (double sample : recorder.samplesNs) totalNs += sample;
+        double megabytes = summary.bytes * recorder.samplesNs.size() / 1e6;
+        recorder.report(exportNames[format]);
+        printf("  %-24s %12.1f MB per export, %.0f MB/s\n", "", summary.bytes / 1e6, megabytes / (totalNs / 1e9));
+    }
+
+    if (memoryAfterRegister > 0) {
+        printf("  memory per event: %.0f bytes (store + indexes), %.0f bytes (with rosters)\n",
+               double(memoryAfterInsert - memoryBefore) / eventCount,
+               double(memoryAfterRegister - memoryBefore) / eventCount);
+    }
+}
+
+// Parses the benchmark options and runs every configured calendar size.
+// Returns false on an unknown option.
+bool runBenchmarks(const vector<string>& options) {
+    BenchConfig config;
+    if (options.size() % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i + 1 < options.size(); i += 2) {
+        const string& name = options[i];
+        const string& value = options[i + 1];
+        bool valid = true;
+        if (name == "--events") {
+            config.sizes.clear();
+            stringstream list(value);
+            string size;
+            while (valid && getline(list, size, ',')) {
+                config.sizes.push_back(0);
+                valid = parseInteger<size_t>(size, config.sizes.back(), 1, MAX_EVENT_CHUNKS * EVENT_CHUNK_SIZE);
+            }
+            valid = valid && !config.sizes.empty();
+        } else if (name == "--days") {
+            valid = parseInteger(value, config.days, 1, DAY_RANGE - daysFromCivil(2024, 1, 1));
+        } else if (name == "--departments") {
+            valid = parseInteger(value, config.departments, 1, numeric_limits<int>::max() / 10); // Locations are 10 per department
+        } else if (name == "--participants") {
+            valid = parseInteger(value, config.participants, 0, MAX_EVENT_CAPACITY - 10); // Capacity is P + 10
+        } else if (name == "--seed") {
+            valid = parseInteger<uint64_t>(value, config.seed, 0, UINT64_MAX);
+        } else {
+            return false;
+        }
+        if (!valid) {
+            reportInvalidOption(name, value);
+            return false;
+        }
+    }
+    for (size_t size : config.sizes) {
+        runBenchmarkSize(config, size);
+    }
+    clearEventStore();
+    return true;
+}
+
+// --- Registration Stress Benchmark ---
+// Registers participants for a handful of events from many threads at once, then checks
+// that no event took more registrations than it has seats and that every accepted
+// registration landed in a slot of its own. Runs in memory; nothing touches disk unless
+// --log is given.
+//
+//   final --bench-register [--events N] [--capacity C] [--threads T] [--attempts A]
+//                          [--seed S] [--log]
+//
+// Each thread makes A attempts at random events. With the defaults the attempts
+// outnumber the seats, so threads race for the last seats of every event and the later
+// attempts are turned away. The same load is then run with every registration behind
+// one store-wide lock, for comparison. With --log every registration is also written to
+// a write-ahead log in the temp directory (synced per group commit), and the log is
+// checked to hold one record per event and accepted registration.
+
+struct RegisterBenchConfig {
+    size_t events = 64;
+    int capacity = 1000;
+    size_t threads = max(2u, thread::hardware_concurrency());
+    size_t attempts = 200000;
+    uint64_t seed = 42;
+    bool logged = false; // Write a log while registering
+};
+
+// Outcome of one stress run.
+struct RegisterRunResult {
+    size_t accepted = 0;
+    size_t rejected = 0;
+    size_t overbookedEvents = 0; // More registrations than seats
+    size_t mismatchedEvents = 0; // Count, column or accepted tally disagree
+    size_t lostRegistrations = 0; // Accepted but missing or duplicated in the rosters
+    double seconds = 0;
+};
+
+// Runs the stress load once on a fresh in-memory store.
+RegisterRunResult runRegisterStress(const RegisterBenchConfig& config, bool storeLock) {
+    clearEventStore();
+    string logPath = (filesystem::temp_directory_path() / "uevents-bench-register.wal").string();
+    if (config.logged) {
+        lock_guard<mutex> guard(walMutex);
+        walFile = openLogFile(logPath.c_str(), "wb");
+        walBytes = 0;
+        walRecordsSinceSnapshot = 0;
+        if (walFile == nullptr) {
+            cerr << "Could not open '" << logPath << "'; running without a log." << endl;
+        }
+    }
+    Event event;
+    for (size_t i = 0; i < config.events; i++) {
+        event.name = "Stress Event " + to_string(i);
+        event.date = daysFromCivil(2024, 1, 1);
+        event.startTime = 9 * 60;
+        event.endTime = 10 * 60;
+        event.location = locationPool.intern("Room " + to_string(i));
+        event.department = departmentPool.intern("Stress Testing");
+        event.capacity = config.capacity;
+        event.participants = 0;
+        insertEvent(event);
+    }
+    const SymbolId course = coursePool.intern("BSCS");
+
+    mutex lock;
+    atomic<bool> started{false};
+    vector<vector<int>> acceptedByThread(config.threads, vector<int>(config.events, 0));
+    auto registerMany = [&](size_t thread) {
+        mt19937_64 rng(config.seed + thread);
+        vector<int>& accepted = acceptedByThread[thread];
+        Participant participant{"", course};
+        while (!started.load()) this_thread::yield();
+        for (size_t attempt = 0; attempt < config.attempts; attempt++) {
+            EventHandle handle = rng() % config.events;
+            participant.name = "Thread " + to_string(thread) + " #" + to_string(attempt);
+            if (storeLock) {
+                lock_guard<mutex> guard(lock);
+                accepted[handle] += addParticipant(handle, participant);
+            } else {
+                accepted[handle] += addParticipant(handle, participant);
+            }
+        }
+    };
+    vector<thread> workers;
+    for (size_t t = 0; t < config.threads; t++) {
+        workers.emplace_back(registerMany, t);
+    }
+    auto startTime = chrono::steady_clock::now();
+    started = true;
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    RegisterRunResult result;
+    result.seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+
+    // Check every event against the tallies the threads kept themselves.
+    vector<string_view> names;
+    for (EventHandle handle = 0; handle < events.size(); handle++) {
+        const Event& stored = events[handle];
+        int accepted = 0;
+        for (const vector<int>& tally : acceptedByThread) accepted += tally[handle];
+        result.accepted += accepted;
+        result.overbookedEvents += stored.participants > stored.capacity;
+        result.mismatchedEvents += stored.participants != accepted || eventColumns.participants[handle] != accepted;
+        for (int i = 0; i < min<int>(stored.participants, stored.capacity); i++) {
+            names.push_back(rosterName(stored.roster[i]));
+        }
+    }
+    result.rejected = config.threads * config.attempts - result.accepted;
+    // Names are unique per attempt, so a slot filled twice shows up as a missing name.
+    sort(names.begin(), names.end());
+    names.erase(unique(names.begin(), names.end()), names.end());
+    result.lostRegistrations = result.accepted - min(result.accepted, names.size());
+
+    if (walFile != nullptr) {
+        // One record per stored event and per accepted registration, and nothing else.
+        result.mismatchedEvents += walRecordsSinceSnapshot != config.events + result.accepted;
+        lock_guard<mutex> guard(walMutex);
+        fclose(walFile);
+        walFile = nullptr;
+        walRecordsSinceSnapshot = 0;
+        remove(logPath.c_str());
+    }
+    return result;
+}
+
+// Parses the stress benchmark options and runs it. Returns 0 if every check passed,
+// 1 if a check failed and 2 on an unknown option.
+int runRegisterBenchmark(const vector<string>& options) {
+    RegisterBenchConfig config;
+    vector<string> valued;
+    for (const string& option : options) {
+        if (option == "--log") {
+            config.logged = true;
+        } else {
+            valued.push_back(option);
+        }
+    }
+    if (valued.size() % 2 != 0) {
+        return 2;
+    }
+    for (size_t i = 0; i + 1 < valued.size(); i += 2) {
+        const string& name = valued[i];
+        const string& value = valued[i + 1];
+        bool valid;
+        if (name == "--events") {
+            valid = parseInteger<size_t>(value, config.events, 1, MAX_EVENT_CHUNKS * EVENT_CHUNK_SIZE);
+        } else if (name == "--capacity") {
+            valid = parseInteger(value, config.capacity, 1, MAX_EVENT_CAPACITY);
+        } else if (name == "--threads") {
+            valid = parseInteger<size_t>(value, config.threads, 1, MAX_BENCH_THREADS);
+        } else if (name == "--attempts") {
+            valid = parseInteger<size_t>(value, config.attempts, 0, SIZE_MAX);
+        } else if (name == "--seed") {
+            valid = parseInteger<uint64_t>(value, config.seed, 0, UINT64_MAX);
+        } else {
+            return 2;
+        }
+        if (!valid) {
+            reportInvalidOption(name, value);
+            return 2;
+        }
+    }
+
+    printf("\n%zu events x %d seats, %zu threads x %zu attempts%s\n", config.events, config.capacity,
+           config.threads, config.attempts, config.logged ? ", logged" : "");
+    printf("  %-20s %12s %12s %14s %11s %9s\n", "mode", "accepted", "rejected", "attempts/sec", "overbooked",
+           "lost");
+    bool passed = true;
+    for (bool storeLock : {false, true}) {
+        RegisterRunResult result = runRegisterStress(config, storeLock);
+        const char* mode = storeLock ? (config.logged ? "store lock + log" : "store-wide lock")
+                                     : (config.logged ? "group commit log" : "atomic seat claims");
+        printf("  %-20s %12zu %12zu %14.0f %11zu %9zu\n", mode,
+               result.accepted, result.rejected,
+               result.seconds > 0 ? (result.accepted + result.rejected) / result.seconds : 0.0,
+               result.overbookedEvents, result.lostRegistrations);
+        passed = passed && result.overbookedEvents == 0 && result.mismatchedEvents == 0 &&
+                 result.lostRegistrations == 0;
+    }
+    clearEventStore();
+    printf("  %s\n", passed ? "✅ No event overbooked; every accepted registration is on a roster."
+                             : "❌ Consistency check failed.");
+    return passed ? 0 : 1;
+}
+
+// --- Reader Latency Benchmark ---
+// Bulk loads a calendar in batches on the main thread while reader threads keep running
+// point lookups, department lists and date-range counts, and reports reader latency
+// during the load and once it has finished. Runs in memory; nothing touches disk.
+//
+//   final --bench-readers [--events N] [--batch B] [--readers R] [--departments K]
+//                         [--seed S]
+//
+// Two runs are made: readers querying published snapshots (the writer publishes one per
+// batch), and for comparison readers querying the live indexes under one store-wide
+// lock that the writer holds for each batch.
+
+// Published index snapshots, the benchmark's alternative to a store-wide lock. Reader
+// threads query an immutable snapshot of the name, department and date orderings rather
+// than the live indexes, which the writer (the main thread) updates in place. After
+// each batch of inserts the writer builds a new snapshot and swaps it in
+// under snapshotLock; a reader copies the pointer under the same lock and queries that
+// version for as long as it holds it. The lock covers only the pointer copy, never a
+// query or an index update, and a superseded snapshot is freed when its last reader
+// lets go of it, so readers never see an index half-way through an update. Department
+// lists that a batch leaves alone are shared between consecutive snapshots.
+//
+// Building a snapshot copies the name and date orderings, O(N) per publish. Nothing
+// outside this benchmark publishes: the application's own readers (menu, batch mode and
+// the server loop) all run on the writer's thread and use the live indexes. The queries
+// mirror the benchmark's store-lock path (exact name and department, a date-range
+// count), not the menu's; findEventsByDepartment(), for one, matches substrings.
+//
+// Snapshots hold handles only. Events never move once stored, the chunk directory of the
+// store never grows, and apart from the atomic participant count an event is not
+// changed after insertion, so a reader may read any event below the snapshot's
+// eventCount while the writer adds more.
+
+typedef shared_ptr<const vector<EventHandle>> SharedHandleList;
+
+struct IndexSnapshot {
+    size_t eventCount = 0;      // Events [0, eventCount) are covered
+    vector<EventHandle> byName; // Name order
+    vector<EventHandle> byDate; // Date order; startsBefore order within a day
+    map<string, SharedHandleList, less<>> byDepartment; // Keyed by department text; name order
+
+    // Returns the handle of the event called 'name', or NO_EVENT.
+    EventHandle findByName(string_view name) const {
+        auto it = lower_bound(byName.begin(), byName.end(), name,
+                              [](EventHandle handle, string_view wanted) { return events[handle].name < wanted; });
+        return it != byName.end() && events[*it].name == name ? *it : NO_EVENT;
+    }
+
+    // Returns the events of a department in name order (empty if there are none).
+    const vector<EventHandle>& inDepartment(string_view department) const {
+        static const vector<EventHandle> none;
+        auto it = byDepartment.find(department);
+        return it == byDepartment.end() ? none : *it->second;
+    }
+
+    // Returns the date-ordered events dated from 'first' to 'last' inclusive.
+    pair<const EventHandle*, const EventHandle*> inDateRange(DayNumber first, DayNumber last) const {
+        auto dated = [](EventHandle handle) { return events[handle].date; };
+        auto from = lower_bound(byDate.begin(), byDate.end(), first,
+                                [&](EventHandle handle, DayNumber day) { return dated(handle) < day; });
+        auto to = upper_bound(from, byDate.end(), last,
+                              [&](DayNumber day, EventHandle handle) { return day < dated(handle); });
+        return {byDate.data() + (from - byDate.begin()), byDate.data() + (to - byDate.begin())};
+    }
+};
+
+// The current snapshot, guarded by snapshotLock (std::atomic<shared_ptr> needs C++20).
+mutex snapshotLock;
+shared_ptr<const IndexSnapshot> publishedSnapshot = make_shared<const IndexSnapshot>();
+
+// Returns the most recently published snapshot. Safe to call from any thread.
+shared_ptr<const IndexSnapshot> currentSnapshot() {
+    lock_guard<mutex> guard(snapshotLock);
+    return publishedSnapshot;
+}
+
+void publishSnapshot(shared_ptr<const IndexSnapshot> snapshot) {
+    shared_ptr<const IndexSnapshot> previous;
+    {
+        lock_guard<mutex> guard(snapshotLock);
+        previous = move(publishedSnapshot);
+        publishedSnapshot = move(snapshot);
+    }
+    // 'previous' is released here, outside the lock, if no reader still holds it.
+}
+
+// Orders events by date, then by start time and name.
+bool datedBefore(EventHandle a, EventHandle b) {
+    if (events[a].date != events[b].date) return events[a].date < events[b].date;
+    return startsBefore(a, b);
+}
+
+// Publishes a snapshot of the whole store, built from the live indexes. 'byName' holds
+// every handle in name order.
+void publishFullSnapshot(const vector<EventHandle>& byName) {
+    auto snapshot = make_shared<IndexSnapshot>();
+    snapshot->eventCount = events.size();
+    snapshot->byName = byName;
+    snapshot->byDate.reserve(events.size());
+    for (const auto& bucket : eventsByDate) {
+        snapshot->byDate.insert(snapshot->byDate.end(), bucket.second.begin(), bucket.second.end());
+    }
+    for (SymbolId department = 0; department < eventsByDepartment.size(); department++) {
+        if (!eventsByDepartment[department].empty()) {
+            snapshot->byDepartment.emplace(departmentPool.text(department),
+                                           make_shared<const vector<EventHandle>>(eventsByDepartment[department]));
+        }
+    }
+    publishSnapshot(move(snapshot));
+}
+
+// Returns sorted 'base' with sorted 'added' merged in. Each added handle's position is
+// found by binary search and the runs of 'base' in between are block-copied, so a small
+// batch costs few comparisons even against a long list.
+template <typename Compare>
+vector<EventHandle> mergeHandles(const vector<EventHandle>& base, const vector<EventHandle>& added, Compare less) {
+    vector<EventHandle> merged;
+    merged.reserve(base.size() + added.size());
+    auto from = base.begin();
+    for (EventHandle handle : added) {
+        auto to = upper_bound(from, base.end(), handle, less);
+        merged.insert(merged.end(), from, to);
+        merged.push_back(handle);
+        from = to;
+    }
+    merged.insert(merged.end(), from, base.end());
+    return merged;
+}
+
+// Publishes a snapshot that also covers the events stored since the last one. The new
+// events are sorted on their own and merged into the previous orderings, so a batch
+// costs a copy of the published lists plus a sort and O(log n) searches per new event.
+void publishNewEvents() {
+    shared_ptr<const IndexSnapshot> previous = currentSnapshot(); // Only this thread publishes
+    if (previous->eventCount == events.size()) {
+        return;
+    }
+    vector<EventHandle> added;
+    added.reserve(events.size() - previous->eventCount);
+    for (EventHandle handle = previous->eventCount; handle < events.size(); handle++) {
+        added.push_back(handle);
+    }
+    auto byName = [](EventHandle a, EventHandle b) { return events[a].name < events[b].name; };
+
+    auto snapshot = make_shared<IndexSnapshot>();
+    snapshot->eventCount = events.size();
+    sort(added.begin(), added.end(), datedBefore);
+    snapshot->byDate = mergeHandles(previous->byDate, added, datedBefore);
+    sort(added.begin(), added.end(), byName);
+    snapshot->byName = mergeHandles(previous->byName, added, byName);
+
+    // Only the departments the batch touches get new lists.
+    snapshot->byDepartment = previous->byDepartment;
+    map<SymbolId, vector<EventHandle>> addedByDepartment;
+    for (EventHandle handle : added) {
+        addedByDepartment[events[handle].department].push_back(handle); // Stays in name order
+    }
+    for (const auto& department : addedByDepartment) {
+        SharedHandleList& list = snapshot->byDepartment[departmentPool.text(department.first)];
+        list = make_shared<const vector<EventHandle>>(
+            list ? mergeHandles(*list, department.second, byName) : department.second);
+    }
+    publishSnapshot(move(snapshot));
+}
+
+// Publishes a snapshot of the whole store. Call before starting reader threads.
+void startSnapshotPublishing() {
+    publishFullSnapshot(eventsInNameOrder());
+}
+
+// Drops the current snapshot. Call after joining reader threads.
+void stopSnapshotPublishing() {
+    publishSnapshot(make_shared<const IndexSnapshot>());
+}
+
+// Stores a batch of events with insertEvent(), skipping names that are already taken,
+// and, if 'publish' is set, publishes them to readers in one new snapshot. Returns the
+// number stored.
+size_t insertEventBatch(const vector<Event>& batch, bool publish) {
+    size_t stored = 0;
+    for (const Event& event : batch) {
+        if (!eventNameIndex.contains(event.name)) {
+            insertEvent(event);
+            stored++;
+        }
+    }
+    if (publish) {
+        publishNewEvents();
+    }
+    return stored;
+}
+
+struct ReaderBenchConfig {
+    size_t events = 1000000;
+    size_t batch = 10000;
+    size_t readers = 4;
+    int departments = 50;
+    uint64_t seed = 42;
+};
+
+// Name of the i-th benchmark event.
+string readerBenchName(size_t i) {
+    return "Event " + to_string(static_cast<uint32_t>(i * 2654435761u));
+}
+
+// Runs one bulk load with readers; 'snapshots' picks the read path. Fills the reader
+// recorders for the load and the idle phase, and the writer's per-batch recorder.
+void runReaderBenchmark(const ReaderBenchConfig& config, bool snapshots, LatencyRecorder& duringLoad,
+                        LatencyRecorder& afterLoad, LatencyRecorder& batches) {
+    clearEventStore();
+    const DayNumber firstDay = daysFromCivil(2024, 1, 1);
+    const int days = 1095;
+    vector<string> departments;
+    for (int k = 0; k < config.departments; k++) {
+        departments.push_back("Department " + to_string(k));
+    }
+
+    mutex storeLock;
+    atomic<size_t> loaded{0}; // Events the readers may look up by name
+    atomic<int> phase{0};     // 0 loading, 1 idle, 2 stop
+    vector<LatencyRecorder> loadRecorders(config.readers), idleRecorders(config.readers);
+    auto read = [&](size_t reader) {
+        mt19937_64 rng(config.seed + 1 + reader);
+        volatile size_t sink = 0;
+        for (size_t query = 0; phase.load() != 2; query++) {
+            int current = phase.load();
+            size_t known = loaded.load();
+            if (known == 0) {
+                this_thread::yield();
+                continue;
+            }
+            string name = readerBenchName(rng() % known);
+            const string& department = departments[rng() % departments.size()];
+            DayNumber first = firstDay + rng() % days;
+            LatencyRecorder& recorder = current == 0 ? loadRecorders[reader] : idleRecorders[reader];
+            recorder.measure([&]() {
+                if (snapshots) {
+                    shared_ptr<const IndexSnapshot> snapshot = currentSnapshot();
+                    if (query % 3 == 0) {
+                        sink = sink + snapshot->findByName(name);
+                    } else if (query % 3 == 1) {
+                        sink = sink + snapshot->inDepartment(department).size();
+                    } else {
+                        auto range = snapshot->inDateRange(first, first + 30);
+                        sink = sink + (range.second - range.first);
+                    }
+                } else {
+                    lock_guard<mutex> guard(storeLock);
+                    if (query % 3 == 0) {
+                        sink = sink + eventNameIndex.find(name);
+                    } else if (query % 3 == 1) {
+                        SymbolId id = departmentPool.find(department);
+                        sink = sink + (id == NO_SYMBOL ? 0 : eventsByDepartment[id].size());
+                    } else {
+                        sink = sink + countEventsInDayRange(first, first + 30);
+                    }
+                }
+            });
+        }
+    };
+    if (snapshots) {
+        startSnapshotPublishing();
+    }
+    vector<thread> readers;
+    for (size_t r = 0; r < config.readers; r++) {
+        readers.emplace_back(read, r);
+    }
+
+    // Writer: build each batch outside the lock, then store (and publish) it.
+    mt19937_64 rng(config.seed);
+    vector<Event> batch;
+    Event event;
+    event.capacity = 20;
+    event.participants = 0;
+    for (size_t next = 0; next < config.events;) {
+        batch.clear();
+        for (; next < config.events && batch.size() < config.batch; next++) {
+            event.name = readerBenchName(next);
+            event.date = firstDay + rng() % days;
+            event.startTime = rng() % (23 * 60);
+            event.endTime = event.startTime + 30 + rng() % 30;
+            event.location = locationPool.intern("Room " + to_string(rng() % (config.departments * 10)));
+            event.department = departmentPool.intern(departments[rng() % departments.size()]);
+            batch.push_back(event);
+        }
+        batches.measure([&]() {
+            if (snapshots) {
+                insertEventBatch(batch, true);
+            } else {
+                lock_guard<mutex> guard(storeLock);
+                insertEventBatch(batch, false);
+            }
+        });
+        loaded = next;
+    }
+    phase = 1;
+    this_thread::sleep_for(chrono::milliseconds(200));
+    phase = 2;
+    for (thread& reader : readers) {
+        reader.join();
+    }
+    if (snapshots) {
+        stopSnapshotPublishing();
+    }
+    for (size_t r = 0; r < config.readers; r++) {
+        duringLoad.samplesNs.insert(duringLoad.samplesNs.end(), loadRecorders[r].samplesNs.begin(),
+                                    loadRecorders[r].samplesNs.end());
+        afterLoad.samplesNs.insert(afterLoad.samplesNs.end(), idleRecorders[r].samplesNs.begin(),
+                                   idleRecorders[r].samplesNs.end());
+    }
+}
+
+// Parses the reader benchmark options and runs both read paths. Returns false on an
+// unknown option.
+bool runReaderBenchmarks(const vector<string>& options) {
+    ReaderBenchConfig config;
+    if (options.size() % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i + 1 < options.size(); i += 2) {
+        const string& name = options[i];
+        const string& value = options[i + 1];
+        bool valid;
+        if (name == "--events") {
+            valid = parseInteger<size_t>(value, config.events, 1, MAX_EVENT_CHUNKS * EVENT_CHUNK_SIZE);
+        } else if (name == "--batch") {
+            valid = parseInteger<size_t>(value, config.batch, 1, SIZE_MAX);
+        } else if (name == "--readers") {
+            valid = parseInteger<size_t>(value, config.readers, 1, MAX_BENCH_THREADS);
+        } else if (name == "--departments") {
+            valid = parseInteger(value, config.departments, 1, numeric_limits<int>::max() / 10); // Locations are 10 per department
+        } else if (name == "--seed") {
+            valid = parseInteger<uint64_t>(value, config.seed, 0, UINT64_MAX);
+        } else {
+            return false;
+        }
+        if (!valid) {
+            reportInvalidOption(name, value);
+            return false;
+        }
+    }
+
+    printf("\n%zu events loaded in batches of %zu, %zu reader threads\n", config.events, config.batch,
+           config.readers);
+    printf("  %-24s %12s %14s %12s %12s\n", "operation", "ops", "ops/sec", "p50 (us)", "p99 (us)");
+    vector<string> worstReads;
+    for (bool snapshots : {true, false}) {
+        LatencyRecorder duringLoad, afterLoad, batches;
+        runReaderBenchmark(config, snapshots, duringLoad, afterLoad, batches);
+        string mode = snapshots ? "snapshot" : "store lock";
+        if (!duringLoad.samplesNs.empty()) {
+            double worst = *max_element(duringLoad.samplesNs.begin(), duringLoad.samplesNs.end());
+            worstReads.push_back(mode + " " + to_string(static_cast<int64_t>(worst / 1e3)) + " us");
+        }
+        batches.report(("insert batch, " + mode).c_str());
+        duringLoad.report(("read during load, " + mode).c_str());
+        afterLoad.report(("read after load, " + mode).c_str());
+    }
+    if (worstReads.size() == 2) {
+        printf("  slowest read during load: %s, %s\n", worstReads[0].c_str(), worstReads[1].c_str());
+    }
+    clearEventStore();
+    return true;
+}
+
+#ifdef __linux__
+// --- Network Server ---
+// final --serve <port> lets many clients use one store at once. It listens on TCP port
+// <port> of the loopback interface and speaks the batch protocol: a request is one batch
+// command line, and the response is that command's JSON line. Responses come back in
+// request order, so clients may pipeline, sending any number of requests before reading
+// the responses. One thread runs an epoll loop over the listening socket and all
+// connections and executes commands in the order they arrive, so the store keeps its
+// single writer and needs no locks. SIGINT or SIGTERM stops the server, which saves a
+// snapshot on the way out.
+
+const int MAX_PORT = 65535;
+const size_t SERVER_READ_SIZE = 1 << 16;    // Bytes read from a connection per wake-up
+const size_t MAX_REQUEST_LINE = 1 << 16;    // A longer request closes the connection
+const size_t MAX_PENDING_OUTPUT = 1 << 22;  // Stop reading a client until it drains this
+const int SERVER_EVENT_BATCH = 256;         // epoll events handled per wait
+
+struct ClientConnection {
+    int fd;
+    string input;        // Received bytes not yet forming a complete line
+    string output;       // Responses not yet sent
+    size_t sent = 0;     // Bytes of 'output' already sent
+    uint32_t watched = 0; // epoll events currently registered
+    bool closing = false; // The client has shut down its side
+};
+
+volatile sig_atomic_t serverStopRequested = 0;
+
+void requestServerStop(int) {
+    serverStopRequested = 1;
+}
+
+// Executes every complete request line in the client's input buffer, appending the
+// responses to its output. Returns false if a request line is too long.
+bool executeClientRequests(ClientConnection& client, vector<string>& fields, size_t& commandCount) {
+    size_t start = 0;
+    string line;
+    while (true) {
+        size_t newline = client.input.find('\n', start);
+        if (newline == string::npos) break;
+        line.assign(client.input, start, newline - start);
+        start = newline + 1;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+        splitTabFields(line, fields);
+        executeBatchCommand(fields, client.output);
+        commandCount++;
+    }
+    client.input.erase(0, start);
+    return client.input.size() <= MAX_REQUEST_LINE;
+}
+
+// Sends as much pending output as the socket accepts. Returns false if the connection
+// has failed.
+bool sendClientOutput(ClientConnection& client) {
+    while (client.sent < client.output.size()) {
+        ssize_t written = send(client.fd, client.output.data() + client.sent, client.output.size() - client.sent,
+                               MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        client.sent += written;
+    }
+    client.output.clear();
+    client.sent = 0;
+    return true;
+}
+
+// Registers interest in input unless the client is closing or far behind on reading its
+// responses, and in writability while output is pending.
+void watchClient(int epollFd, ClientConnection& client) {
+    size_t pending = client.output.size() - client.sent;
+    uint32_t wanted = 0;
+    if (!client.closing && pending < MAX_PENDING_OUTPUT) wanted |= EPOLLIN;
+    if (pending > 0) wanted |= EPOLLOUT;
+    if (wanted != client.watched) {
+        epoll_event event{};
+        event.events = wanted;
+        event.data.fd = client.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, client.fd, &event);
+        client.watched = wanted;
+    }
+}
+
+// Opens a listening TCP socket on the loopback interface, or returns -1.
+int listenOnLoopback(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Serves clients until SIGINT or SIGTERM. Returns false if the server could not start.
+bool runServer(int port) {
+    int listener = listenOnLoopback(port);
+    if (listener < 0) {
+        cerr << "Could not listen on 127.0.0.1:" << port << ": " << strerror(errno) << endl;
+        return false;
+    }
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = listener;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listener, &listenEvent);
+
+    // No SA_RESTART, so a signal interrupts epoll_wait and the loop sees the request.
+    struct sigaction stop{};
+    stop.sa_handler = requestServerStop;
+    sigaction(SIGINT, &stop, nullptr);
+    sigaction(SIGTERM, &stop, nullptr);
+    fprintf(stderr, "Serving on 127.0.0.1:%d (Ctrl+C to stop)\n", port);
+
+    unordered_map<int, unique_ptr<ClientConnection>> clients;
+    vector<epoll_event> ready(SERVER_EVENT_BATCH);
+    vector<string> fields;
+    vector<char> buffer(SERVER_READ_SIZE);
+    size_t commandCount = 0;
+    size_t connectionCount = 0;
+    auto disconnect = [&](ClientConnection& client) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, client.fd, nullptr);
+        close(client.fd);
+        clients.erase(client.fd);
+    };
+
+    while (!serverStopRequested) {
+        int readyCount = epoll_wait(epollFd, ready.data(), ready.size(), -1);
+        if (readyCount < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+        for (int i = 0; i < readyCount; i++) {
+            if (ready[i].data.fd == listener) {
+                int fd;
+                while ((fd = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    int noDelay = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                    auto client = make_unique<ClientConnection>();
+                    client->fd = fd;
+                    client->watched = EPOLLIN;
+                    epoll_event event{};
+                    event.events = EPOLLIN;
+                    event.data.fd = fd;
+                    epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+                    clients.emplace(fd, move(client));
+                    connectionCount++;
+                }
+                continue;
+            }
+            auto found = clients.find(ready[i].data.fd);
+            if (found == clients.end()) continue;
+            ClientConnection& client = *found->second;
+
+            bool healthy = (ready[i].events & EPOLLERR) == 0;
+            if (healthy && (ready[i].events & (EPOLLIN | EPOLLHUP)) && !client.closing) {
+                ssize_t received = recv(client.fd, buffer.data(), buffer.size(), 0);
+                if (received > 0) {
+                    client.input.append(buffer.data(), received);
+                    healthy = executeClientRequests(client, fields, commandCount);
+                } else if (received == 0) {
+                    client.closing = true; // Answer what has arrived, then close
+                } else if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                    healthy = false;
+                }
+            }
+            healthy = healthy && sendClientOutput(client);
+            if (!healthy || (client.closing && client.output.empty())) {
+                disconnect(client);
+            } else {
+                watchClient(epollFd, client);
+            }
+        }
+        checkpointIfDue();
+    }
+
+    for (auto& entry : clients) {
+        close(entry.first);
+    }
+    close(epollFd);
+    close(listener);
+    fprintf(stderr, "Server stopped: %zu commands from %zu connections\n", commandCount, connectionCount);
+    return true;
+}
+
+// --- Load Generator ---
+// final --loadgen <port> [--connections C] [--requests N] [--pipeline P] [--events E]
+//                        [--seed S]
+// Drives a running server over loopback. It first adds E events through one connection,
+// then opens C connections, each on its own thread, that send N requests apiece in
+// windows of P pipelined requests: 45% searches, 25% registrations, 10% department
+// listings, 15% date range counts and 5% new events. It reports throughput and per-request latency, measured
+// from the write of a request's window to the arrival of its response line.
+
+struct LoadgenConfig {
+    int port = 0;
+    size_t connections = 8;
+    size_t requests = 20000;
+    size_t pipeline = 16;
+    size_t events = 1000;
+    uint64_t seed = 42;
+};
+
+// Upper bounds for the per-connection options, so a typo cannot exhaust file descriptors
+// or memory before the first request is sent.
+const size_t MAX_LOADGEN_CONNECTIONS = 10000;
+const size_t MAX_LOADGEN_PIPELINE = 1 << 16;
+
+// Number of departments and locations the load generator's events are spread over.
+const int LOADGEN_DEPARTMENTS = 50;
+const int LOADGEN_LOCATIONS = 200;
+
+// Connects to the loopback interface, or returns -1.
+int connectToLoopback(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    return fd;
+}
+
+// Blocking client side of one connection: sends request windows and reads response lines.
+struct LoadgenClient {
+    int fd = -1;
+    string buffer; // Received bytes after the last complete line
+    size_t failedResponses = 0; // Responses with "ok":false
+
+    bool sendAll(const string& data) {
+        for (size_t done = 0; done < data.size();) {
+            ssize_t written = send(fd, data.data() + done, data.size() - done, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            done += written;
+        }
+        return true;
+    }
+
+    // Waits for 'count' response lines, calling 'arrived' as each completes.
+    template <typename F>
+    bool receiveLines(size_t count, F&& arrived) {
+        char chunk[1 << 16];
+        while (count > 0) {
+            size_t newline;
+            while (count > 0 && (newline = buffer.find('\n')) != string::npos) {
+                if (string_view(buffer.data(), newline).find("\"ok\":false") != string_view::npos) {
+                    failedResponses++;
+                }
+                buffer.erase(0, newline + 1);
+                arrived();
+                count--;
+            }
+            if (count == 0) break;
+            ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                if (received < 0 && errno == EINTR) continue;
+                return false;
+            }
+            buffer.append(chunk, received);
+        }
+        return true;
+    }
+};
+
+// Name of a load generator department. Two digits, so that listing one department by
+// substring does not also match others.
+string loadgenDepartment(int department) {
+    char name[32];
+    snprintf(name, sizeof(name), "Department %02d", department);
+    return name;
+}
+
+// Appends one "add" request for an event called 'name'.
+void appendLoadgenAdd(string& out, const string& name, mt19937_64& rng) {
+    DayNumber day = daysFromCivil(2025, 1, 1) + rng() % 365;
+    int start = 8 * 60 + rng() % (10 * 60);
+    out += "add\t" + name + "\t" + formatDate(day) + "\t" + formatTime(start) + "\t" + formatTime(start + 60) +
+           "\tRoom " + to_string(rng() % LOADGEN_LOCATIONS) + "\t" + loadgenDepartment(rng() % LOADGEN_DEPARTMENTS) +
+           "\t50\n";
+}
+
+// Runs the load. Returns false if the server cannot be reached or a connection fails.
+bool runLoadgen(const LoadgenConfig& config) {
+    // Seed the store in pipelined windows; names already there are simply reported taken.
+    LoadgenClient seeder;
+    seeder.fd = connectToLoopback(config.port);
+    if (seeder.fd < 0) {
+        cerr << "Could not connect to 127.0.0.1:" << config.port << ": " << strerror(errno) << endl;
+        return false;
+    }
+    mt19937_64 seedRng(config.seed);
+    for (size_t next = 0; next < config.events;) {
+        string window;
+        size_t count = 0;
+        for (; next < config.events && count < 256; next++, count++) {
+            appendLoadgenAdd(window, "Load Event " + to_string(next), seedRng);
+        }
+        if (!seeder.sendAll(window) || !seeder.receiveLines(count, []() {})) {
+            cerr << "Connection lost while adding events." << endl;
+            close(seeder.fd);
+            return false;
+        }
+    }
+    close(seeder.fd);
+
+    vector<LatencyRecorder> recorders(config.connections); // Only collect samples
+    vector<size_t> failures(config.connections, 0);
+    atomic<size_t> brokenConnections{0};
+    auto drive = [&](size_t connection) {
+        LoadgenClient client;
+        client.fd = connectToLoopback(config.port);
+        if (client.fd < 0) {
+            brokenConnections++;
+            return;
+        }
+        mt19937_64 rng(config.seed + 1 + connection);
+        LatencyRecorder& recorder = recorders[connection];
+        string window;
+        for (size_t sent = 0; sent < config.requests;) {
+            window.clear();
+            size_t count = 0;
+            for (; sent < config.requests && count < config.pipeline; sent++, count++) {
+                string event = "Load Event " + to_string(rng() % max<size_t>(1, config.events));
+                unsigned kind = rng() % 20;
+                if (kind < 9) {
+                    window += "search\t" + event + "\n";
+                } else if (kind < 14) {
+                    window += "register\t" + event + "\tLoad Participant " + to_string(connection) + "-" +
+                              to_string(sent) + "\tBSCS\n";
+                } else if (kind < 16) {
+                    window += "list-dept\t" + loadgenDepartment(rng() % LOADGEN_DEPARTMENTS) + "\n";
+                } else if (kind < 19) {
+                    DayNumber first = daysFromCivil(2025, 1, 1) + rng() % 365;
+                    window += "range-count\t" + formatDate(first) + "\t" + formatDate(first + 30) + "\n";
+                } else {
+                    appendLoadgenAdd(window, "Load Extra " + to_string(connection) + "-" + to_string(sent), rng);
+                }
+            }
+            auto windowStart = chrono::steady_clock::now();
+            bool delivered = client.sendAll(window) && client.receiveLines(count, [&]() {
+                recorder.samplesNs.push_back(
+                    chrono::duration<double, nano>(chrono::steady_clock::now() - windowStart).count());
+            });
+            if (!delivered) {
+                brokenConnections++;
+                break;
+            }
+        }
+        failures[connection] = client.failedResponses;
+        close(client.fd);
+    };
+
+    auto started = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (size_t c = 0; c < config.connections; c++) {
+        workers.emplace_back(drive, c);
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+    vector<double> latencies;
+    size_t failed = 0;
+    for (size_t c = 0; c < config.connections; c++) {
+        latencies.insert(latencies.end(), recorders[c].samplesNs.begin(), recorders[c].samplesNs.end());
+        failed += failures[c];
+    }
+    printf("\n%zu connections x %zu requests, %zu pipelined per window, %zu seeded events\n", config.connections,
+           config.requests, config.pipeline, config.events);
+    printf("  answered %zu requests in %.3f s: %.0f requests/s\n", latencies.size(), seconds,
+           seconds > 0 ? latencies.size() / seconds : 0.0);
+    if (!latencies.empty()) {
+        sort(latencies.begin(), latencies.end());
+        printf("  latency p50 %.1f us, p99 %.1f us, max %.1f us\n", latencies[latencies.size() / 2] / 1e3,
+               latencies[min(latencies.size() - 1, latencies.size() * 99 / 100)] / 1e3, latencies.back() / 1e3);
+    }
+    printf("  %zu answered \"ok\":false (full events, taken names, ...)\n", failed);
+    if (brokenConnections > 0) {
+        printf("  %zu connections failed\n", brokenConnections.load());
+        return false;
+    }
+    return true;
+}
+
+// Parses the load generator options. Returns false on an unknown option or a value that
+// is not a number in the option's range.
+bool parseLoadgenOptions(const vector<string>& options, LoadgenConfig& config) {
+    if (options.empty() || options.size() % 2 != 1) {
+        return false;
+    }
+    if (!parseInteger(options[0], config.port, 1, MAX_PORT)) {
+        reportInvalidOption("the port", options[0]);
+        return false;
+    }
+    for (size_t i = 1; i + 1 < options.size(); i += 2) {
+        const string& name = options[i];
+        const string& text = options[i + 1];
+        bool valid;
+        if (name == "--connections") {
+            valid = parseInteger<size_t>(text, config.connections, 1, MAX_LOADGEN_CONNECTIONS);
+        } else if (name == "--requests") {
+            valid = parseInteger<size_t>(text, config.requests, 0, numeric_limits<size_t>::max());
+        } else if (name == "--pipeline") {
+            valid = parseInteger<size_t>(text, config.pipeline, 1, MAX_LOADGEN_PIPELINE);
+        } else if (name == "--events") {
+            valid = parseInteger<size_t>(text, config.events, 0, numeric_limits<size_t>::max());
+        } else if (name == "--seed") {
+            valid = parseInteger<uint64_t>(text, config.seed, 0, numeric_limits<uint64_t>::max());
+        } else {
+            return false;
+        }
+        if (!valid) {
+            reportInvalidOption(name, text);
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+// --- Self-Test ---
+// Checks edge cases that the menu rarely exercises, such as malformed import records.
+// Runs in memory and prints every failed check.
+//
+//   final --self-test
+//
+// Exits with status 0 if every check passed.
+
+size_t selfTestChecks = 0;
+size_t selfTestFailures = 0;
+
+// Records the outcome of one check.
+void expect(bool condition, const char* description) {
+    selfTestChecks++;
+    if (!condition) {
+        selfTestFailures++;
+        printf("FAIL: %s\n", description);
+    }
+}
+
+// Parses 'text' as the lines of a JSON-lines import file.
+ImportChunk parseJsonLinesForTest(const string& text) {
+    ImportChunk chunk;
+    parseImportChunk(text.data(), text.data() + text.size(), text.data() + text.size(), true, chunk);
+    return chunk;
+}
+
+// \u escapes: valid ones decode to UTF-8; bad or truncated ones make the line malformed
+// instead of throwing out of the import worker.
+void testJsonEscapes() {
+    vector<pair<string, string>> fields;
+    string object = R"({"name":"caf\u00e9 \ud83d\ude00"})";
+    expect(parseJsonObject(object.data(), object.data() + object.size(), fields) && fields.size() == 1 &&
+               fields[0].second == "caf\xc3\xa9 \xf0\x9f\x98\x80",
+           "\\u escapes and surrogate pairs decode to UTF-8");
+    for (const char* bad : {R"({"name":"\uzzzz"})", R"({"name":"\u12"})", R"({"name":"\u1)",
+                            R"({"name":"\ud83d"})", R"({"name":"\ud83d\u0041"})", R"({"name":"\ude00"})"}) {
+        expect(!parseJsonObject(bad, bad + strlen(bad), fields), "bad \\u escape is rejected");
+    }
+
+    ImportChunk chunk = parseJsonLinesForTest(
+        R"({"type":"event","name":"\uzzzz","date":"2030-01-01","start":"09:00","end":"10:00","location":"L","department":"D","capacity":5})"
+        "\n"
+        R"({"type":"event","name":"Cut \u00)"
+        "\n"
+        R"({"type":"event","name":"Fine","date":"2030-01-01","start":"09:00","end":"10:00","location":"L","department":"D","capacity":5})"
+        "\n");
+    expect(chunk.malformedLines == 2, "lines with bad or truncated escapes are counted as malformed");
+    expect(chunk.events.size() == 1 && chunk.events[0].name == "Fine", "lines after a bad escape still import");
+}
+
+// Returns the contents of a file, or an empty string if it cannot be read.
+string readFileForTest(const string& path) {
+    ifstream in(path, ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+// Every export format imports back to the same store: exporting the re-imported store
+// gives the same bytes. Names hold commas, quotes and line breaks, and there are enough
+// events for the CSV importer to split the file between threads inside quoted fields.
+void testExportRoundTrip() {
+    clearEventStore();
+    for (int i = 0; i < 4000; i++) {
+        Event event;
+        event.name = "Talk " + to_string(i) + ",\n\"part\" two\r\nend";
+        parseDate("2030-03-01", event.date);
+        event.date += i; // One booking per day, so none conflict
+        event.startTime = 9 * 60;
+        event.endTime = 10 * 60;
+        event.location = locationPool.intern("Hall, \"A\"");
+        event.department = departmentPool.intern("Physics\nLab");
+        event.capacity = 8;
+        EventHandle handle = insertEvent(event);
+        for (int seat = 0; seat < i % 4; seat++) {
+            appendRosterEntry(events[handle], "Student\n" + to_string(seat), coursePool.intern("CS, \"101\""));
+        }
+    }
+    updateSecondaryDataStructures();
+
+    for (const char* extension : {".csv", ".jsonl", ".bin"}) {
+        string path = (filesystem::temp_directory_path() / (string("uevents-self-test") + extension)).string();
+        ExportSummary summary;
+        bool exported = exportEventsToFile(path, summary);
+        string original = readFileForTest(path);
+        size_t eventCount = events.size();
+
+        clearEventStore();
+        ImportSummary imported;
+        bool loaded = importEventsFromFile(path, imported);
+        expect(exported && loaded && imported.malformedLines == 0 && events.size() == eventCount,
+               "an export imports back without malformed records");
+        expect(exportEventsToFile(path, summary) && readFileForTest(path) == original,
+               "re-exporting an imported export gives the same bytes");
+        filesystem::remove(path);
+    }
+
+    // A damaged binary export is refused and leaves the store as it was.
+    string path = (filesystem::temp_directory_path() / "uevents-self-test-damaged.bin").string();
+    ExportSummary summary;
+    exportEventsToFile(path, summary);
+    string damaged = readFileForTest(path);
+    damaged[damaged.size() / 2] ^= 1;
+    ofstream(path, ios::binary) << damaged;
+    size_t eventCount = events.size();
+    ImportSummary imported;
+    expect(!importEventsFromFile(path, imported) && events.size() == eventCount,
+           "a binary export with a bad checksum is rejected");
+    filesystem::remove(path);
+    clearEventStore();
+}
+
+// A quoted CSV field may span lines; a chunk cut inside it is read on past the cut.
+void testCsvLineBreaks() {
+    string text = "event,\"Two\nlines\",2030-01-01,09:00,10:00,L,D,5\nregister,\"Two\nlines\",Ann,CS\n";
+    const char* end = text.data() + text.size();
+    ImportChunk chunk;
+    const char* cut = text.data() + text.find('\n') + 1; // Inside the first quoted name
+    parseImportChunk(text.data(), cut, end, false, chunk);
+    expect(chunk.malformedLines == 0 && chunk.events.size() == 1 && chunk.events[0].name == "Two\nlines",
+           "a quoted line break stays in the field");
+    expect(chunk.parsedEnd == text.data() + text.find("register"), "the record that straddles a cut is read whole");
+}
+
+// Imported events that overlap a stored booking, or an earlier one in the same file,
+// are skipped and counted, as addEvent() would refuse them.
+void testImportBookingConflicts() {
+    clearEventStore();
+    Event stored;
+    makeImportedEvent("Stored", "2030-05-01", "09:00", "10:00", "Hall", "D", "5", locationPool, departmentPool, stored);
+    insertEvent(stored);
+
+    string path = (filesystem::temp_directory_path() / "uevents-self-test-conflicts.csv").string();
+    ofstream(path, ios::binary) << "event,Overlaps stored,2030-05-01,09:30,11:00,Hall,D,5\n"
+                                   "event,After stored,2030-05-01,10:00,11:00,Hall,D,5\n"
+                                   "event,Overlaps earlier row,2030-05-01,10:30,12:00,Hall,D,5\n"
+                                   "event,Other hall,2030-05-01,09:30,11:00,Annex,D,5\n"
+                                   "register,Overlaps stored,Ann,CS\n";
+    ImportSummary summary;
+    importEventsFromFile(path, summary);
+    expect(summary.eventsAdded == 2 && summary.conflictingEvents == 2, "conflicting imported bookings are skipped");
+    expect(summary.rejectedRegistrations == 1, "registrations for a skipped booking are rejected");
+    expect(findAllBookingConflicts().empty(), "an import leaves no overlapping bookings");
+    filesystem::remove(path);
+    clearEventStore();
+}
+
+// Runs every check. Returns false if any failed.
+bool runSelfTests() {
+    testImportBookingConflicts();
+    testJsonEscapes();
+    testCsvLineBreaks();
+    testExportRoundTrip();
+    printf("%zu checks, %zu failed\n", selfTestChecks, selfTestFailures);
+    return selfTestFailures == 0;
+}
+
+// Menu choice that exits the application (always the last menu entry).
+const int EXIT_CHOICE = 13;
+
+// Creative Terminal Interface - UEvent Organizer
+// Displays the main menu for the application.
+void displayMenu() {
+    cout << "\n";
+    cout << "  ╔═════════════════════════════════════════════════╗\n";
+    cout << "  ║                                                 ║\n";
+    cout << "  ║             ██████╗ ███████╗ ██████╗            ║\n";
+    cout << "  ║            ██╔════╝ ██╔════╝██╔═══██╗           ║\n";
+    cout << "  ║            ██║  ███╗███████╗██║   ██║           ║\n";
+    cout << "  ║            ██║  ██╔╝╚════██║██║   ██║           ║\n";
+    cout << "  ║            ╚██████║ ███████║╚██████╔╝           ║\n";
+    cout << "  ║             ╚═════╝ ╚══════╝ ╚═════╝            ║\n";
+    cout << "  ║                                                 ║\n";
+    cout << "  ║              ✨ UEvent Organizer ✨             ║\n";
+    cout << "  ║                                                 ║\n";
+    cout << "  ╚═════════════════════════════════════════════════╝\n";
+    cout << "  [1] ➕ Add New UEvent\n";
+    cout << "  [2] 📜 View All UEvents\n";
+    cout << "  [3] 🔍 Search UEvent by Name\n";
+    cout << "  [4] ✍️ Register for a UEvent\n";
+    cout << "  [5] 🏷️ View UEvents by Department\n";
+    cout << "  [6] 📅 View UEvents Sorted by Date \n"; // Streams the maintained date ordering
+    cout << "  [7] 🔎 Search UEvents by Date \n";    // Looks up the day's date bucket
+    cout << "  [8] 📊 List UEvents by Date Range \n"; // Fenwick Tree count + date buckets for the events
+    cout << "  [9] ⚠️ Booking Conflict Report \n"; // Sweep over location/day schedules
+    cout << "  [10] 📥 Import UEvents from File \n"; // Parallel CSV / JSON-lines loader
+    cout << "  [11] 🎟️ Capacity & Occupancy Report \n"; // Scan over the event columns
+    cout << "  [12] 📤 Export UEvents to File \n"; // Streaming CSV / JSON-lines / binary writer
+    cout << "  [13] 🚪 Exit\n"; // Exit option.
+    cout << "  " << string(45, '-') << "\n";
+    cout << "  ➡️ Enter your choice: ";
+}
+
+// Command-line usage:
+//   final                        interactive menu
+//   final --import <file>        bulk import a CSV / JSON-lines file or a binary export, then exit
+//   final --export <file>        export events and rosters (.csv/.jsonl/.bin), then exit
+//   final --batch [file]         run batch commands from a file (or stdin), then exit
+//   final --bench [options]      run the micro-benchmark suite in memory, then exit
+//   final --self-test            run the built-in checks in memory, then exit
+//   final --bench-register [...] run the concurrent registration stress test, then exit
+//   final --bench-readers [...]  time readers against a concurrent bulk load, then exit
+//   final --serve <port>         serve batch commands to TCP clients on 127.0.0.1 (Linux)
+//   final --loadgen <port> [...] drive a running server and report latency (Linux)
+// Adding --in-memory to any mode starts from an empty store and saves nothing.
+int main(int argc, char* argv[]) {
+    vector<string> args(argv + 1, argv + argc);
+    bool inMemory = false;
+    auto inMemoryFlag = find(args.begin(), args.end(), "--in-memory");
+    if (inMemoryFlag != args.end()) {
+        inMemory = true;
+        args.erase(inMemoryFlag);
+    }
+
+    // Benchmarks always run on synthetic in-memory data: final --bench [options]
+    if (!args.empty() && args[0] == "--bench") {
+        if (!runBenchmarks(vector<string>(args.begin() + 1, args.end()))) {
+            cerr << "Usage: final --bench [--events N,N,...] [--days D] [--departments K] "
+                    "[--participants P] [--seed S]" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Built-in checks, also in memory: final --self-test
+    if (args.size() == 1 && args[0] == "--self-test") {
+        return runSelfTests() ? 0 : 1;
+    }
+
+    // Concurrent registration stress test, also in memory: final --bench-register [options]
+    if (!args.empty() && args[0] == "--bench-register") {
+        int status = runRegisterBenchmark(vector<string>(args.begin() + 1, args.end()));
+        if (status == 2) {
+            cerr << "Usage: final --bench-register [--events N] [--capacity C] [--threads T] "
+                    "[--attempts A] [--seed S] [--log]" << endl;
+        }
+        return status;
+    }
+
+    // Reader latency during a bulk load, also in memory: final --bench-readers [options]
+    if (!args.empty() && args[0] == "--bench-readers") {
+        if (!runReaderBenchmarks(vector<string>(args.begin() + 1, args.end()))) {
+            cerr << "Usage: final --bench-readers [--events N] [--batch B] [--readers R] "
+                    "[--departments K] [--seed S]" << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Load generator for a running server: final --loadgen <port> [options]
+    if (!args.empty() && args[0] == "--loadgen") {
+#ifdef __linux__
+        LoadgenConfig config;
+        if (!parseLoadgenOptions(vector<string>(args.begin() + 1, args.end()), config)) {
+            cerr << "Usage: final --loadgen <port> [--connections C] [--requests N] [--pipeline P] "
+                    "[--events E] [--seed S]" << endl;
+            return 1;
+        }
+        return runLoadgen(config) ? 0 : 1;
+#else
+        cerr << "The load generator is only available on Linux." << endl;
+        return 1;
+#endif
+    }
+
+    // Restore saved events (snapshot + log) and build all secondary data structures once.
+    // This sets up all necessary data structures before the menu loop begins.
+    if (inMemory) {
+        updateSecondaryDataStructures();
+    } else if (!openEventStore()) {
+        return 1;
+    }
+
+    // Non-interactive bulk import: final --import <file>
+    if (args.size() == 2 && args[0] == "--import") {
+        bool imported = runImport(args[1]);
+        bool saved = closeEventStore(); // Retries the snapshot if the import's own one failed
+        return imported && saved ? 0 : 1;
+    }
+
+    // Non-interactive export: final --export <file>
+    if (args.size() == 2 && args[0] == "--export") {
+        bool exported = runExport(args[1]);
+        closeEventStore();
+        return exported ? 0 : 1;
+    }
+
+    // Network front end: final --serve <port>
+    if (args.size() == 2 && args[0] == "--serve") {
+#ifdef __linux__
+        int port;
+        if (!parseInteger(args[1], port, 1, MAX_PORT)) {
+            reportInvalidOption("--serve", args[1]);
+            cerr << "Usage: final --serve <port>   (port 1-65535)" << endl;
+            closeEventStore();
+            return 1;
+        }
+        bool served = runServer(port);
+        closeEventStore();
+        return served ? 0 : 1;
+#else
+        cerr << "The server is only available on Linux." << endl;
+        closeEventStore();
+        return 1;
+#endif
+    }
+
+    // Non-interactive command stream: final --batch [file]
+    if (!args.empty() && args[0] == "--batch" && args.size() <= 2) {
+        ios::sync_with_stdio(false);
+        if (args.size() == 2) {
+            ifstream input(args[1]);
+            if (!input) {
+                cerr << "Could not open '" << args[1] << "'." << endl;
+                return 1;
+            }
+            runBatch(input);
+        } else {
+            runBatch(cin);
+        }
+        closeEventStore();
+        return 0;
+    }
+
+    int choice;
+    do {
+        clearScreen(); // Clear the screen before displaying the menu each time
+        displayMenu();
+        // Input validation for menu choice.
+        while (!(cin >> choice)) {
+            cout << "Invalid input. Please enter a number: ";
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        }
+
+        switch (choice) {
+            case 1:
+                addEvent();
+                break;
+            case 2:
+                displayAllEvents();
+                break;
+            case 3:
+                searchEvent();
+                break;
+            case 4:
+                registerParticipant();
+                break;
+            case 5:
+                displayEventsByDepartment();
+                break;
+            case 6:
+                displayEventsSortedByDate();
+                break;
+            case 7:
+                searchEventsByDate();
+                break;
+            case 8: // Fenwick Tree functionality
+                queryEventsByDateRange();
+                break;
+            case 9:
+                displayBookingConflicts();
+                break;
+            case 10:
+                importEvents();
+                break;
+            case 11:
+                displayCapacityReport();
+                break;
+            case 12:
+                exportEvents();
+                break;
+            case EXIT_CHOICE: // Exit option
+                clearScreen(); // Clear one last time before exiting
+                closeEventStore(); // Save a snapshot so the next start is fast
+                cout << "\n👋 Exiting UEvent Organizer. Have a great day! 👋\n";
+                break;
+            default:
+                cout << "\n⚠️ Invalid choice. Please try again. ⚠️\n";
+        }
+        checkpointIfDue(); // Between operations, so never inside a mutation
+        if (choice != EXIT_CHOICE) { // Don't pause if exiting
+            cout << "\nPress Enter to continue...";
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cin.get(); // Wait for user to press Enter
+        }
+    } while (choice != EXIT_CHOICE); // Loop continues until user chooses to exit.
+
+    return 0;
 }
\ No newline at end of file